@@ -15,8 +15,11 @@ if not exist "%SFML_DIR%\include" (
     exit /b 1
 )
 
+REM Engine (model layer) - biên dịch cùng main.cpp
+set MODEL_SOURCES=model\Piece.cpp model\Position.cpp model\Bitboard.cpp model\Zobrist.cpp model\Evaluation.cpp model\Move.cpp model\Board.cpp model\MoveGenerator.cpp model\GameState.cpp model\TranspositionTable.cpp model\MoveOrdering.cpp model\MappedFile.cpp model\OpeningBook.cpp model\Bitbase.cpp model\NNUE.cpp model\AIPlayer.cpp
+
 echo Compiling main.cpp...
-g++ -std=c++17 main.cpp -o ChessGame.exe ^
+g++ -std=c++17 -pthread -I. main.cpp %MODEL_SOURCES% -o ChessGame.exe ^
   -I"%SFML_DIR%\include" ^
   -L"%SFML_DIR%\lib" ^
     -lsfml-graphics-s -lsfml-window-s -lsfml-system-s ^
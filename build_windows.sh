@@ -16,8 +16,8 @@ mkdir -p build_win
 
 echo "Compiling main.cpp for Windows..."
 
-# Compile main.cpp (nó include tất cả các file khác)
-x86_64-w64-mingw32-g++ -std=c++17 main.cpp -o ChessGame.exe \
+# Compile main.cpp (include view/controller) + engine (model/*.cpp)
+x86_64-w64-mingw32-g++ -std=c++17 -pthread -I. main.cpp model/*.cpp -o ChessGame.exe \
     -lsfml-graphics -lsfml-window -lsfml-system \
     -static-libgcc -static-libstdc++
 
@@ -1,7 +1,7 @@
 #!/bin/bash
 
 # Script biên dịch Chess Game - MVC Architecture
-# Chỉ cần compile main.cpp (nó include tất cả các file khác)
+# main.cpp (include view/controller) + model/*.cpp (engine chess-core)
 
 echo "==================================="
 echo "Compiling Chess Game (MVC)..."
@@ -9,18 +9,18 @@ echo "==================================="
 
 # Compiler và flags
 CXX=g++
-CXXFLAGS="-std=c++17 -Wall -Wextra"
+CXXFLAGS="-std=c++17 -Wall -Wextra -pthread"
 LIBS="-lsfml-graphics -lsfml-window -lsfml-system"
 
-# Source file (chỉ cần main.cpp)
-SOURCE="main.cpp"
+# Source files: main.cpp + engine (model layer)
+SOURCE="main.cpp model/*.cpp"
 
 # Output binary
 OUTPUT="ChessGame"
 
 # Compile
 echo "Compiling $SOURCE..."
-$CXX $CXXFLAGS $SOURCE $LIBS -o $OUTPUT
+$CXX $CXXFLAGS -I. $SOURCE $LIBS -o $OUTPUT
 
 if [ $? -eq 0 ]; then
     echo "==================================="
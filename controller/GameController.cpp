@@ -15,6 +15,9 @@ enum class GamePhase {
 
 class GameController {
 private:
+    // Thời gian AI suy nghĩ mỗi nước (ms) - độ sâu do iterative deepening tự quyết định
+    static const int AI_MOVE_TIME_MS = 1000;
+    
     GameState gameState;
     AIPlayer aiPlayer;
     BoardView boardView;
@@ -27,7 +30,7 @@ private:
     // Interaction state
     Position selectedSquare;
     bool pieceSelected;
-    std::vector<Move> currentLegalMoves;
+    MoveList currentLegalMoves;
     Move pendingPromotionMove;
     
     // Menu state
@@ -50,6 +53,7 @@ private:
                 if (menuSelection == 0) { // New Game
                     currentPhase = GamePhase::MODE_SELECT;
                 } else if (menuSelection == 1) { // Load Game
+                    aiPlayer.cancelSearch();
                     if (SaveLoadManager::loadGame(gameState, gameMode, "public/save.txt")) {
                         currentPhase = GamePhase::PLAYING;
                     }
@@ -82,6 +86,9 @@ private:
      * Handle game input (mouse clicks)
      */
     void handleGameInput(const sf::Event& event) {
+        // Đang đợi AI => bỏ qua click (gameState thuộc lượt AI)
+        if (isAITurn()) return;
+        
         if (event.type == sf::Event::MouseButtonPressed) {
             if (event.mouseButton.button == sf::Mouse::Left) {
                 int x = event.mouseButton.x;
@@ -104,7 +111,7 @@ private:
                         std::vector<Move> pieceMoves;
                         
                         for (const Move& move : currentLegalMoves) {
-                            if (move.from == selectedSquare) {
+                            if (move.from() == selectedSquare) {
                                 pieceMoves.push_back(move);
                             }
                         }
@@ -119,7 +126,7 @@ private:
                     // Tìm move trong legal moves
                     bool found = false;
                     for (const Move& legalMove : currentLegalMoves) {
-                        if (legalMove.from == selectedSquare && legalMove.to == clickedSquare) {
+                        if (legalMove.from() == selectedSquare && legalMove.to() == clickedSquare) {
                             move = legalMove;
                             found = true;
                             break;
@@ -128,7 +135,7 @@ private:
                     
                     if (found) {
                         // Kiểm tra promotion
-                        if (move.moveType == MoveType::PROMOTION) {
+                        if (move.moveType() == MoveType::PROMOTION) {
                             pendingPromotionMove = move;
                             currentPhase = GamePhase::PROMOTION;
                         } else {
@@ -165,7 +172,7 @@ private:
                 return; // Invalid key
             }
             
-            pendingPromotionMove.promotionPiece = promoted;
+            pendingPromotionMove.setPromotionPiece(promoted);
             gameState.makeMove(pendingPromotionMove);
             
             currentPhase = GamePhase::PLAYING;
@@ -178,6 +185,7 @@ private:
      * Start new game
      */
     void startNewGame() {
+        aiPlayer.cancelSearch();
         gameState.reset();
         currentPhase = GamePhase::PLAYING;
         pieceSelected = false;
@@ -186,7 +194,14 @@ private:
     }
     
     /**
-     * Check nếu game over (checkmate/stalemate)
+     * Có phải lượt AI (BLACK trong PVE) không
+     */
+    bool isAITurn() const {
+        return gameMode == GameMode::PVE_AI && gameState.getCurrentTurn() == PieceColor::BLACK;
+    }
+    
+    /**
+     * Check nếu game over (checkmate/stalemate/lặp lại 3 lần/luật 50 nước)
      */
     void checkGameOver() {
         PieceColor currentTurn = gameState.getCurrentTurn();
@@ -199,6 +214,12 @@ private:
         } else if (gameState.isStalemate(currentTurn)) {
             statusMessage = "Stalemate! (Draw)";
             currentPhase = GamePhase::GAME_OVER;
+        } else if (gameState.repetitionCount() >= 2) {
+            statusMessage = "Threefold Repetition! (Draw)";
+            currentPhase = GamePhase::GAME_OVER;
+        } else if (gameState.getHalfmoveClock() >= 100) {
+            statusMessage = "50-Move Rule! (Draw)";
+            currentPhase = GamePhase::GAME_OVER;
         } else if (gameState.isInCheck(currentTurn)) {
             statusMessage = "Check!";
         } else {
@@ -211,8 +232,23 @@ public:
      * Constructor
      */
     GameController() 
-        : aiPlayer(3), currentPhase(GamePhase::MENU), gameMode(GameMode::PVP),
+        : aiPlayer(AIPlayer::MAX_SEARCH_DEPTH), currentPhase(GamePhase::MENU), gameMode(GameMode::PVP),
           pieceSelected(false), menuSelection(0), modeSelection(0) {
+        aiPlayer.setTimeLimit(AI_MOVE_TIME_MS);
+        aiPlayer.setThreads(static_cast<int>(std::thread::hardware_concurrency()));
+        
+        // Có weights NNUE thì dùng, không thì giữ đánh giá material
+        if (aiPlayer.loadNetwork("public/network.nnue")) {
+            aiPlayer.setEvaluator(Evaluator::NNUE);
+        }
+        
+        // Opening book Polyglot, thiếu file thì search từ nước đầu
+        if (aiPlayer.loadOpeningBook("public/book.bin")) {
+            aiPlayer.setUseBook(true);
+        }
+        
+        // Bitbase tàn cuộc (sinh bằng tool bitbase), thiếu thì search bình thường
+        aiPlayer.loadBitbases("public/bitbases");
     }
     
     /**
@@ -236,14 +272,19 @@ public:
     void update() {
         if (currentPhase == GamePhase::PLAYING) {
             // Nếu là AI mode và đến lượt AI (BLACK)
-            if (gameMode == GameMode::PVE_AI && 
-                gameState.getCurrentTurn() == PieceColor::BLACK) {
+            if (isAITurn()) {
+                // AI tính nước đi trên worker thread => frame không bị chặn
+                if (!aiPlayer.isSearching()) {
+                    aiPlayer.startSearch(gameState);
+                    return;
+                }
+                if (!aiPlayer.isSearchDone()) return;
                 
-                // AI tính nước đi
-                Move aiMove = aiPlayer.getBestMove(gameState);
+                Move aiMove = aiPlayer.takeResult();
                 
-                if (aiMove.from.isValid()) {
-                    gameState.makeMove(aiMove);
+                if (!aiMove.isNull()) {
+                    // Move lấy từ legal moves của chính vị trí này => không cần kiểm tra lại
+                    gameState.applyMove(aiMove);
                     checkGameOver();
                     
                     // Save game sau mỗi nước đi
@@ -280,4 +321,9 @@ public:
      */
     int getMenuSelection() const { return menuSelection; }
     GamePhase getCurrentPhase() const { return currentPhase; }
+    
+    /**
+     * Dừng AI search đang chạy (khi đóng cửa sổ)
+     */
+    void shutdown() { aiPlayer.cancelSearch(); }
 };
@@ -88,9 +88,10 @@ public:
         }
         
         // Read FEN
+        std::string fen;
         if (std::getline(file, line)) {
             if (line.find("FEN:") != std::string::npos) {
-                std::string fen = line.substr(4); // Skip "FEN:"
+                fen = line.substr(4); // Skip "FEN:"
                 if (!state.loadFromFEN(fen)) {
                     std::cerr << "ERROR: Invalid FEN in save file" << std::endl;
                     file.close();
@@ -99,10 +100,24 @@ public:
             }
         }
         
-        // Read history (optional, for display purposes)
-        if (std::getline(file, line)) {
-            // Parse history if needed
-            // For now, we skip since state is already loaded from FEN
+        // Read history: replay từ vị trí đầu qua makeMove (có kiểm tra hợp lệ)
+        // để khôi phục lịch sử nước đi; nếu không khớp FEN thì giữ state từ FEN
+        if (std::getline(file, line) && line.find("HISTORY:") == 0 && !fen.empty()) {
+            GameState replayed;
+            std::stringstream ss(line.substr(8)); // Skip "HISTORY:"
+            std::string notation;
+            bool valid = true;
+            
+            while (valid && std::getline(ss, notation, ',')) {
+                if (notation.empty()) continue;
+                valid = replayed.makeMove(Move::fromNotation(notation));
+            }
+            
+            // So theo vị trí (hash), không so halfmove/fullmove: file save cũ chỉ có 4 trường FEN
+            // Bản replay còn giữ lịch sử vị trí để phát hiện lặp lại 3 lần
+            if (valid && replayed.hash() == state.hash()) {
+                state = replayed;
+            }
         }
         
         file.close();
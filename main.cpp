@@ -4,15 +4,11 @@
 #include <SFML/Graphics.hpp>
 #include <iostream>
 
-// Include all components in correct order
-// Model layer
-#include "model/Piece.cpp"
-#include "model/Position.cpp"
-#include "model/Move.cpp"
-#include "model/Board.cpp"
-#include "model/MoveGenerator.cpp"
-#include "model/GameState.cpp"
-#include "model/AIPlayer.cpp"
+// Model layer (thư viện chess-core, link riêng)
+#include "model/GameState.h"
+#include "model/AIPlayer.h"
+
+// View/Controller: include theo thứ tự phụ thuộc
 
 // View layer
 #include "view/AssetManager.cpp"
@@ -74,6 +70,9 @@ int main() {
         window.display();
     }
     
+    // Dừng AI search (nếu đang chạy) trước khi thoát
+    controller.shutdown();
+    
     std::cout << "Game closed. Thank you for playing!\n";
     return 0;
 }
@@ -1,135 +1,602 @@
+#include "AIPlayer.h"
+
 #include <algorithm>
-#include <climits>
-#include <vector>
+#include <cstdlib>
+#include <cmath>
+
+int AIPlayer::evaluatePosition(SearchThread& thread) {
+    const GameState& state = thread.state;
+    
+    // Tàn cuộc có trong bitbase: điểm chắc chắn thay cho đánh giá tĩnh
+    if (!bitbases.empty()) {
+        BitbaseResult result = bitbases.probe(state.getBoard(), state.getCurrentTurn());
+        if (result != BitbaseResult::UNKNOWN) return bitbaseScore(state, result);
+    }
+    
+    if (evaluator == Evaluator::NNUE && network) {
+        // Kẹp lại để không lẫn với điểm mate
+        int score = network->evaluate(state.getBoard(), state.getCurrentTurn(), thread.nnue);
+        return std::clamp(score, -MATE_BOUND + 1, MATE_BOUND - 1);
+    }
+    
+    // Material + piece-square tables, cộng dồn sẵn trong Board (O(1))
+    // Chiếu hết / hết nước do search nhận ra từ danh sách nước rỗng, không xét ở đây
+    return state.staticEvaluation(state.getCurrentTurn());
+}
+
+/**
+ * Điểm mate trong TT tính theo khoảng cách tới mate từ chính node đó (không từ gốc),
+ * để cùng vị trí gặp ở ply khác vẫn ra đúng số nước tới mate
+ */
+static int scoreToTT(int score, int ply) {
+    if (score >= AIPlayer::MATE_BOUND) return score + ply;
+    if (score <= -AIPlayer::MATE_BOUND) return score - ply;
+    return score;
+}
+
+static int scoreFromTT(int score, int ply) {
+    if (score >= AIPlayer::MATE_BOUND) return score - ply;
+    if (score <= -AIPlayer::MATE_BOUND) return score + ply;
+    return score;
+}
+
+int AIPlayer::bitbaseScore(const GameState& state, BitbaseResult result) const {
+    if (result == BitbaseResult::DRAW) return 0;
+    
+    PieceColor turn = state.getCurrentTurn();
+    PieceColor winner = (result == BitbaseResult::WIN) ? turn : oppositeColor(turn);
+    const Board& board = state.getBoard();
+    
+    // Dồn vua thua ra mép bàn và đưa vua thắng lại gần
+    int loserKing = board.kingSquare(oppositeColor(winner));
+    int winnerKing = board.kingSquare(winner);
+    int loserRow = loserKing >> 3, loserCol = loserKing & 7;
+    int centerDistance = std::max(3 - loserRow, loserRow - 4) + std::max(3 - loserCol, loserCol - 4);
+    int kingDistance = std::abs(loserRow - (winnerKing >> 3)) + std::abs(loserCol - (winnerKing & 7));
+    
+    int score = KNOWN_WIN + state.staticEvaluation(winner) + 10 * centerDistance + 4 * (14 - kingDistance);
+    
+    // Còn tốt: ưu tiên đẩy tốt tới phong cấp
+    Bitboard pawns = board.pieces(PieceType::PAWN, winner);
+    while (pawns) {
+        int row = popLsb(pawns) >> 3;
+        score += 50 * ((winner == PieceColor::WHITE) ? 6 - row : row - 1);
+    }
+    
+    return (result == BitbaseResult::WIN) ? score : -score;
+}
 
 /**
- * Class AI player sử dụng Minimax với Alpha-Beta pruning
- * Tham khảo từ example.cpp nhưng refactor theo MVC
+ * Bảng giảm độ sâu của LMR theo (độ sâu, thứ tự nước): ~ ln(depth) * ln(moveIndex) / 2
  */
-class AIPlayer {
-private:
-    int searchDepth;  // Độ sâu search (3 = medium difficulty)
+struct ReductionTable {
+    int values[AIPlayer::MAX_SEARCH_DEPTH + 1][MoveList::MAX_MOVES];
     
-    /**
-     * Đánh giá vị trí hiện tại dựa trên material value
-     */
-    int evaluatePosition(const GameState& state) {
-        int blackMaterial = state.calculateMaterialValue(PieceColor::BLACK);
-        int whiteMaterial = state.calculateMaterialValue(PieceColor::WHITE);
+    ReductionTable() {
+        for (int depth = 0; depth <= AIPlayer::MAX_SEARCH_DEPTH; depth++) {
+            for (int index = 0; index < MoveList::MAX_MOVES; index++) {
+                values[depth][index] = (depth == 0 || index == 0) ? 0
+                    : static_cast<int>(0.5 + std::log(depth) * std::log(index) / 2.0);
+            }
+        }
+    }
+};
+
+static const ReductionTable& reductions() {
+    static const ReductionTable table;
+    return table;
+}
+
+/**
+ * Còn quân ngoài vua và tốt: null move an toàn (tàn cuộc chỉ tốt dễ zugzwang)
+ */
+static bool hasNonPawnMaterial(const Board& board, PieceColor color) {
+    return (board.pieces(color) & ~board.pieces(PieceType::PAWN) & ~board.pieces(PieceType::KING)) != 0;
+}
+
+int AIPlayer::negamax(SearchThread& thread, int depth, int ply, int alpha, int beta, bool allowNull) {
+    // Bị hủy / hết giờ: thoát nhanh, kết quả sẽ bị bỏ
+    if (shouldStop(thread)) {
+        return 0;
+    }
+    
+    thread.countNode();
+    GameState& state = thread.state;
+    MoveOrderer& orderer = thread.orderer;
+    
+    // Check extension không giảm depth => chặn theo ply để stack không tràn
+    if (ply >= MoveOrderer::MAX_PLY - 1) {
+        return evaluatePosition(thread);
+    }
+    
+    // Lặp lại vị trí đã có (trong ván hoặc trên nhánh đang search) => hòa
+    // Không lưu TT vì phụ thuộc đường đi tới node
+    if (state.repetitionCount(1) > 0) {
+        return 0;
+    }
+    
+    // Luật 50 nước: hòa, trừ khi nước cuối là chiếu hết
+    // Xét trước TT vì entry cùng key có thể đến từ vị trí có halfmove clock nhỏ hơn
+    if (state.getHalfmoveClock() >= 100) {
+        if (state.isInCheck(state.getCurrentTurn()) && state.getLegalMoves().empty()) {
+            return -(MATE_SCORE - ply);
+        }
+        return 0;
+    }
+    
+    bool pvNode = beta - alpha > 1;
+    
+    // Tra transposition table (điểm theo bên đang đi ở node đó)
+    ZobristKey key = state.hash();
+    TTEntry entry;
+    std::uint16_t hashMove = 0;
+    if (tt.probe(key, entry)) {
+        if (entry.depth >= depth) {
+            int ttScore = scoreFromTT(entry.score, ply);
+            if (entry.bound() == Bound::EXACT) return ttScore;
+            if (entry.bound() == Bound::LOWER && ttScore >= beta) return ttScore;
+            if (entry.bound() == Bound::UPPER && ttScore <= alpha) return ttScore;
+        }
+        hashMove = entry.move;
+    }
+    
+    // Hết độ sâu: giải quyết tiếp các chuỗi bắt quân trước khi đánh giá
+    if (depth <= 0) {
+        int eval = quiescence(thread, ply, alpha, beta);
+        if (thread.aborted) return 0;
         
-        int evaluation = blackMaterial - whiteMaterial;
+        // Chỉ lưu fail-high (rẻ để tính lại, không lấp cluster bằng entry độ sâu 0);
+        // store() vẫn giữ entry sâu hơn cùng key
+        if (eval >= beta) tt.store(key, 0, scoreToTT(eval, ply), Bound::LOWER, Move());
+        return eval;
+    }
+    
+    PieceColor turn = state.getCurrentTurn();
+    bool inCheck = state.isInCheck(turn);
+    
+    // Null move: bỏ lượt mà vẫn >= beta thì nước thật gần như chắc chắn cũng vậy
+    // Zugzwang: không dùng khi bị chiếu, khi chỉ còn vua + tốt, hay hai lần liên tiếp;
+    // depth lớn thì kiểm tra lại bằng search thường (không null) ở độ sâu giảm
+    if (searchOptions.nullMove && allowNull && !pvNode && !inCheck && depth >= NULL_MOVE_MIN_DEPTH &&
+        std::abs(beta) < MATE_BOUND && hasNonPawnMaterial(state.getBoard(), turn) &&
+        evaluatePosition(thread) >= beta) {
+        int reduction = 2 + depth / 4;
+        
+        thread.applyNullMove();
+        int score = -negamax(thread, depth - 1 - reduction, ply + 1, -beta, -beta + 1, false);
+        thread.unmakeNullMove();
+        
+        if (thread.aborted) return 0;
+        
+        if (score >= beta) {
+            if (depth < NULL_VERIFY_DEPTH ||
+                negamax(thread, depth - 1 - reduction, ply, beta - 1, beta, false) >= beta) {
+                // Không trả điểm mate chưa được chứng minh
+                return (score >= MATE_BOUND) ? beta : score;
+            }
+        }
+    }
+    
+    MoveList moves = state.getLegalMoves();
+    
+    // Không còn nước đi: chiếu hết (mate càng gần càng tốt cho bên thắng) hoặc hết nước (hòa)
+    if (moves.empty()) {
+        int eval = inCheck ? -(MATE_SCORE - ply) : 0;
+        tt.store(key, depth, scoreToTT(eval, ply), Bound::EXACT, Move());
+        return eval;
+    }
+    
+    // Bitbase báo hòa chắc chắn => không search tiếp
+    // Thắng/thua vẫn search để tìm đường mate, bitbase chỉ thay đánh giá ở lá
+    if (!bitbases.empty() &&
+        bitbases.probe(state.getBoard(), turn) == BitbaseResult::DRAW) {
+        tt.store(key, depth, 0, Bound::EXACT, Move());
+        return 0;
+    }
+    
+    // Chấm điểm nước đi; mỗi vòng lặp lấy nước điểm cao nhất còn lại
+    int scores[MoveList::MAX_MOVES];
+    orderer.scoreMoves(state.getBoard(), moves, hashMove, ply, scores);
+    
+    int alphaOrig = alpha;
+    int bestEval = -INFINITE_SCORE;
+    Move bestMove;
+    
+    for (size_t i = 0; i < moves.size(); i++) {
+        MoveOrderer::pickNext(moves, scores, i);
+        const Move& move = moves[i];
+        bool quiet = MoveOrderer::isQuiet(move);
+        
+        thread.applyMove(move);
+        bool givesCheck = state.isInCheck(state.getCurrentTurn());
+        int newDepth = depth - 1 + ((searchOptions.checkExtensions && givesCheck) ? 1 : 0);
+        
+        // LMR: nước yên tĩnh xếp cuối hiếm khi tốt nhất => search nông hơn trước
+        int reduction = 0;
+        if (searchOptions.lateMoveReductions && depth >= LMR_MIN_DEPTH && i >= LMR_FULL_MOVES &&
+            quiet && !inCheck && !givesCheck) {
+            int tableDepth = (depth < MAX_SEARCH_DEPTH) ? depth : MAX_SEARCH_DEPTH;
+            reduction = reductions().values[tableDepth][i] - (pvNode ? 1 : 0);
+            reduction = std::clamp(reduction, 0, newDepth - 1);
+        }
+        
+        int eval;
+        if (i == 0) {
+            eval = -negamax(thread, newDepth, ply + 1, -beta, -alpha, true);
+        } else {
+            // PVS: chỉ cần chứng minh nước này không hơn alpha (null window);
+            // vượt alpha thì search lại đầy đủ độ sâu rồi đầy đủ cửa sổ
+            int scoutBeta = searchOptions.principalVariation ? alpha + 1 : beta;
+            eval = -negamax(thread, newDepth - reduction, ply + 1, -scoutBeta, -alpha, true);
+            if (reduction > 0 && eval > alpha) {
+                eval = -negamax(thread, newDepth, ply + 1, -scoutBeta, -alpha, true);
+            }
+            if (scoutBeta != beta && eval > alpha && eval < beta) {
+                eval = -negamax(thread, newDepth, ply + 1, -beta, -alpha, true);
+            }
+        }
+        thread.unmakeMove();
+        
+        if (thread.aborted) break;
         
-        // Bonus/penalty cho game over
-        if (state.isCheckmate(PieceColor::WHITE)) {
-            evaluation += 10000;
-        } else if (state.isCheckmate(PieceColor::BLACK)) {
-            evaluation -= 10000;
+        if (eval > bestEval) {
+            bestEval = eval;
+            bestMove = move;
         }
+        alpha = std::max(alpha, eval);
+        
+        if (alpha >= beta) {
+            orderer.recordCutoff(state.getBoard(), move, ply, depth);
+            break;
+        }
+    }
+    
+    // Search bị hủy giữa chừng => kết quả không đáng tin, không lưu
+    if (thread.aborted) {
+        return 0;
+    }
+    
+    Bound bound = (bestEval <= alphaOrig) ? Bound::UPPER
+                : (bestEval >= beta) ? Bound::LOWER
+                : Bound::EXACT;
+    tt.store(key, depth, scoreToTT(bestEval, ply), bound, bestMove);
+    
+    return bestEval;
+}
+
+int AIPlayer::quiescence(SearchThread& thread, int ply, int alpha, int beta) {
+    if (shouldStop(thread)) {
+        return 0;
+    }
+    
+    thread.countNode();
+    GameState& state = thread.state;
+    
+    if (ply >= MoveOrderer::MAX_PLY) {
+        return evaluatePosition(thread);
+    }
+    
+    // Bị chiếu: không được đứng yên, phải xét mọi nước thoát chiếu (hết nước = bị chiếu hết)
+    bool inCheck = state.isInCheck(state.getCurrentTurn());
+    
+    // Stand pat: bên đang đi có thể không bắt gì và giữ điểm hiện tại
+    int standPat = -INFINITE_SCORE;
+    if (!inCheck) {
+        standPat = evaluatePosition(thread);
+        if (standPat >= beta) return standPat;
+        alpha = std::max(alpha, standPat);
+    }
+    
+    MoveList moves = inCheck ? state.getLegalMoves() : state.getLegalCaptures();
+    if (inCheck && moves.empty()) {
+        return -(MATE_SCORE - ply);
+    }
+    
+    int scores[MoveList::MAX_MOVES];
+    thread.orderer.scoreMoves(state.getBoard(), moves, 0, ply, scores);
+    
+    int bestEval = standPat;
+    
+    for (size_t i = 0; i < moves.size(); i++) {
+        MoveOrderer::pickNext(moves, scores, i);
+        const Move& move = moves[i];
         
-        if (state.isStalemate(PieceColor::WHITE) || state.isStalemate(PieceColor::BLACK)) {
-            evaluation = 0;
+        // Delta pruning: kể cả được trọn quân bị bắt (+ phong cấp) cũng không kéo điểm lên tới alpha
+        // (Piece::value x10 => centipawn như staticEvaluation)
+        int gain = move.capturedPiece().value * 10 + DELTA_MARGIN;
+        if (move.moveType() == MoveType::PROMOTION) {
+            gain += (Piece(move.promotionPiece(), PieceColor::WHITE).value - Piece(PieceType::PAWN, PieceColor::WHITE).value) * 10;
+        }
+        if (!inCheck && standPat + gain <= alpha) {
+            continue;
         }
         
-        return evaluation;
+        thread.applyMove(move);
+        int eval = -quiescence(thread, ply + 1, -beta, -alpha);
+        thread.unmakeMove();
+        
+        if (thread.aborted) return 0;
+        
+        bestEval = std::max(bestEval, eval);
+        alpha = std::max(alpha, eval);
+        
+        if (alpha >= beta) {
+            break;
+        }
     }
     
-    /**
-     * Minimax algorithm với Alpha-Beta pruning
-     */
-    int minimax(GameState& state, int depth, bool isMaximizing, int alpha, int beta) {
-        if (depth == 0) {
-            return evaluatePosition(state);
+    return bestEval;
+}
+
+int AIPlayer::elapsedMs() const {
+    return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - searchStart).count());
+}
+
+bool AIPlayer::shouldStop(SearchThread& thread) {
+    if (thread.aborted) return true;
+    
+    if (stopRequested.load(std::memory_order_relaxed) || helpersStop.load(std::memory_order_relaxed)) {
+        thread.aborted = true;
+    } else if (thread.id == 0) {
+        // Giới hạn node/thời gian chỉ do thread chính kiểm tra; helper dừng theo helpersStop
+        // Đọc đồng hồ và cộng node mọi thread mỗi 1024 node cho rẻ
+        if ((thread.nodeCount() & 1023) == 0) {
+            if (nodeLimit > 0 && getNodeCount() >= nodeLimit) {
+                thread.aborted = true;
+            } else if (timeLimitMs > 0 && elapsedMs() >= timeLimitMs) {
+                thread.aborted = true;
+            }
         }
+    }
+    
+    return thread.aborted;
+}
+
+int AIPlayer::searchRoot(SearchThread& thread, MoveList& moves, int depth, int alpha, int beta, Move& bestMove) {
+    GameState& state = thread.state;
+    int bestScore = -INFINITE_SCORE;
+    
+    for (size_t i = 0; i < moves.size(); i++) {
+        const Move& move = moves[i];
         
-        std::vector<Move> moves = state.getLegalMoves();
+        thread.applyMove(move);
+        bool givesCheck = state.isInCheck(state.getCurrentTurn());
+        int newDepth = depth - 1 + ((searchOptions.checkExtensions && givesCheck) ? 1 : 0);
         
-        if (moves.empty()) {
-            return evaluatePosition(state);
+        int score;
+        if (i == 0 || !searchOptions.principalVariation) {
+            score = -negamax(thread, newDepth, 1, -beta, -alpha, true);
+        } else {
+            score = -negamax(thread, newDepth, 1, -alpha - 1, -alpha, true);
+            if (score > alpha && score < beta) {
+                score = -negamax(thread, newDepth, 1, -beta, -alpha, true);
+            }
         }
+        thread.unmakeMove();
         
-        if (isMaximizing) {
-            int maxEval = INT_MIN;
-            
-            for (const Move& move : moves) {
-                GameState tempState = state;
-                tempState.makeMove(move);
-                
-                int eval = minimax(tempState, depth - 1, false, alpha, beta);
-                
-                maxEval = std::max(maxEval, eval);
-                alpha = std::max(alpha, eval);
-                
-                if (beta <= alpha) {
-                    break;
-                }
+        if (thread.aborted) break;
+        
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move;
+        }
+        
+        alpha = std::max(alpha, bestScore);
+        if (alpha >= beta) break;  // Fail high của aspiration window
+    }
+    
+    return bestScore;
+}
+
+void AIPlayer::helperSearch(SearchThread& thread, MoveList moves) {
+    // Helper lệch độ sâu bắt đầu và xoay thứ tự nước gốc => mỗi thread tỏa ra nhánh khác,
+    // điền vào TT chung những vị trí mà thread chính sắp cần
+    std::rotate(moves.begin(), moves.begin() + (thread.id % moves.size()), moves.end());
+    
+    for (int depth = 1 + (thread.id & 1); depth <= searchDepth; depth++) {
+        Move iterationBest;
+        searchRoot(thread, moves, depth, -INFINITE_SCORE, INFINITE_SCORE, iterationBest);
+        if (thread.aborted) break;
+        
+        for (size_t i = 1; i < moves.size(); i++) {
+            if (moves[i] == iterationBest) {
+                std::swap(moves[0], moves[i]);
+                break;
             }
-            
-            return maxEval;
-            
+        }
+    }
+}
+
+Move AIPlayer::getBestMove(GameState& state) {
+    MoveList moves = state.getLegalMoves();
+    
+    if (moves.empty()) {
+        return Move();
+    }
+    
+    tt.newSearch();
+    searchStart = std::chrono::steady_clock::now();
+    helpersStop = false;
+    
+    // Mỗi thread search trên bản copy GameState riêng
+    for (std::unique_ptr<SearchThread>& thread : threads) {
+        thread->state = state;
+        thread->nodes = 0;
+        thread->aborted = false;
+        thread->orderer.newSearch();
+        if (getEvaluator() == Evaluator::NNUE) {
+            network->resetStack(state.getBoard(), thread->nnue);
         } else {
-            int minEval = INT_MAX;
+            thread->nnue.reset();
+        }
+    }
+    SearchThread& main = *threads[0];
+    
+    // Chỉ có 1 nước => không cần search
+    if (moves.size() == 1) {
+        return moves[0];
+    }
+    
+    // Vị trí có trong opening book => đi nước book ngay
+    if (useBook) {
+        Move bookMove = book.probe(state);
+        if (!bookMove.isNull()) return bookMove;
+    }
+    
+    // Sắp xếp nước gốc một lần (hash move của lượt trước, bắt quân...);
+    // các vòng sau chỉ đưa nước tốt nhất lên đầu
+    TTEntry entry;
+    std::uint16_t hashMove = tt.probe(state.hash(), entry) ? entry.move : 0;
+    int scores[MoveList::MAX_MOVES];
+    main.orderer.scoreMoves(state.getBoard(), moves, hashMove, 0, scores);
+    for (size_t i = 0; i < moves.size(); i++) {
+        MoveOrderer::pickNext(moves, scores, i);
+    }
+    
+    // Lazy SMP: helper search song song, chỉ chia sẻ transposition table
+    std::vector<std::thread> helpers;
+    for (size_t i = 1; i < threads.size(); i++) {
+        SearchThread* helper = threads[i].get();
+        helpers.emplace_back([this, helper, moves]() { helperSearch(*helper, moves); });
+    }
+    
+    Move bestMove = moves[0];
+    int previousScore = 0;
+    
+    // Iterative deepening: mỗi vòng sâu thêm 1, giữ kết quả của vòng hoàn tất gần nhất
+    for (int depth = 1; depth <= searchDepth; depth++) {
+        Move iterationBest;
+        int score;
+        
+        if (searchOptions.aspirationWindows && depth >= ASPIRATION_MIN_DEPTH &&
+            std::abs(previousScore) < MATE_BOUND) {
+            // Aspiration: cửa sổ hẹp quanh điểm vòng trước, fail thì nới rộng phía đó và search lại
+            int window = ASPIRATION_WINDOW;
+            int alpha = previousScore - window;
+            int beta = previousScore + window;
             
-            for (const Move& move : moves) {
-                GameState tempState = state;
-                tempState.makeMove(move);
-                
-                int eval = minimax(tempState, depth - 1, true, alpha, beta);
+            while (true) {
+                score = searchRoot(main, moves, depth, alpha, beta, iterationBest);
+                if (main.aborted) break;
                 
-                minEval = std::min(minEval, eval);
-                beta = std::min(beta, eval);
-                
-                if (beta <= alpha) {
+                window *= 2;
+                if (score <= alpha) {
+                    alpha = previousScore - window;
+                } else if (score >= beta) {
+                    beta = previousScore + window;
+                } else {
                     break;
                 }
             }
-            
-            return minEval;
+        } else {
+            score = searchRoot(main, moves, depth, -INFINITE_SCORE, INFINITE_SCORE, iterationBest);
         }
-    }
-
-public:
-    /**
-     * Constructor
-     * @param depth: độ sâu search (1-5, khuyến nghị 3)
-     */
-    AIPlayer(int depth = 3) : searchDepth(depth) {}
-    
-    /**
-     * Lấy nước đi tốt nhất cho AI
-     * @param state: game state hiện tại (AI là BLACK)
-     * @return nước đi tốt nhất
-     */
-    Move getBestMove(GameState& state) {
-        std::vector<Move> moves = state.getLegalMoves();
         
-        if (moves.empty()) {
-            return Move();
+        if (main.aborted) {
+            // Vòng bị cắt giữa chừng: chỉ dùng khi chưa có vòng nào hoàn tất
+            if (depth == 1 && !iterationBest.isNull()) {
+                bestMove = iterationBest;
+            }
+            break;
         }
         
-        Move bestMove = moves[0];
-        int bestScore = INT_MIN;
-        int alpha = INT_MIN;
-        int beta = INT_MAX;
+        bestMove = iterationBest;
+        previousScore = score;
+        tt.store(state.hash(), depth, score, Bound::EXACT, bestMove);
         
-        for (const Move& move : moves) {
-            GameState tempState = state;
-            tempState.makeMove(move);
-            
-            int score = minimax(tempState, searchDepth - 1, false, alpha, beta);
-            
-            if (score > bestScore) {
-                bestScore = score;
-                bestMove = move;
+        if (infoCallback) {
+            SearchInfo info;
+            info.depth = depth;
+            info.score = (state.getCurrentTurn() == PieceColor::BLACK) ? score : -score;
+            info.bestMove = bestMove;
+            info.nodes = getNodeCount();
+            info.elapsedMs = elapsedMs();
+            infoCallback(info);
+        }
+        
+        // Nước tốt nhất lên đầu cho vòng sau
+        for (size_t i = 1; i < moves.size(); i++) {
+            if (moves[i] == bestMove) {
+                std::swap(moves[0], moves[i]);
+                break;
             }
-            
-            alpha = std::max(alpha, bestScore);
         }
         
-        return bestMove;
+        // Vòng sau thường tốn gấp vài lần vòng này => không bắt đầu nếu đã dùng quá nửa thời gian
+        if (timeLimitMs > 0 && elapsedMs() * 2 >= timeLimitMs) {
+            break;
+        }
     }
     
-    /**
-     * Set độ khó (search depth)
-     */
-    void setDifficulty(int depth) { searchDepth = depth; }
-};
+    // Thread chính xong => dừng các helper
+    helpersStop = true;
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+    
+    return bestMove;
+}
+
+void AIPlayer::setThreads(int count) {
+    count = std::max(1, count);
+    threads.clear();
+    for (int i = 0; i < count; i++) {
+        threads.emplace_back(new SearchThread(i));
+    }
+}
+
+bool AIPlayer::loadNetwork(const std::string& path) {
+    std::unique_ptr<NNUENetwork> loaded(new NNUENetwork());
+    if (!loaded->load(path)) return false;
+    
+    network = std::move(loaded);
+    return true;
+}
+
+void AIPlayer::clearHash() {
+    tt.clear();
+    for (std::unique_ptr<SearchThread>& thread : threads) {
+        thread->orderer.clear();
+    }
+}
+
+long long AIPlayer::getNodeCount() const {
+    long long total = 0;
+    for (const std::unique_ptr<SearchThread>& thread : threads) {
+        total += thread->nodeCount();
+    }
+    return total;
+}
+
+void AIPlayer::startSearch(const GameState& state) {
+    cancelSearch();
+    
+    searchState = state;
+    searchResult = Move();
+    stopRequested = false;
+    searchDone = false;
+    
+    worker = std::thread([this]() {
+        // Bị dừng sớm vẫn giữ nước của độ sâu hoàn tất gần nhất (stopSearch)
+        searchResult = getBestMove(searchState);
+        searchDone = true;
+    });
+}
+
+Move AIPlayer::takeResult() {
+    if (worker.joinable()) {
+        worker.join();
+    }
+    searchDone = false;
+    return searchResult;
+}
+
+void AIPlayer::cancelSearch() {
+    stopRequested = true;
+    if (worker.joinable()) {
+        worker.join();
+    }
+    stopRequested = false;
+    searchDone = false;
+}
@@ -0,0 +1,345 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+
+#include "GameState.h"
+#include "TranspositionTable.h"
+#include "MoveOrdering.h"
+#include "NNUE.h"
+#include "OpeningBook.h"
+#include "Bitbase.h"
+
+/**
+ * Thông tin báo cáo sau mỗi độ sâu hoàn tất của iterative deepening
+ */
+struct SearchInfo {
+    int depth;          // Độ sâu vừa hoàn tất
+    int score;          // Điểm (theo phía Black)
+    Move bestMove;      // Nước tốt nhất tại độ sâu này
+    long long nodes;    // Tổng số node từ đầu lượt search
+    int elapsedMs;      // Thời gian đã dùng
+};
+
+/**
+ * Hàm đánh giá tĩnh dùng ở node lá
+ */
+enum class Evaluator {
+    MATERIAL,   // Material + piece-square tables (GameState::staticEvaluation)
+    NNUE        // Mạng NNUE (cần loadNetwork thành công, nếu không sẽ dùng MATERIAL)
+};
+
+/**
+ * Bật/tắt từng kỹ thuật search chọn lọc (đo riêng từng cái bằng bench --search)
+ */
+struct SearchOptions {
+    bool principalVariation = true;   // PVS: nước đầu cửa sổ đầy đủ, các nước sau null window
+    bool aspirationWindows = true;    // Cửa sổ hẹp quanh điểm vòng trước ở gốc
+    bool nullMove = true;             // Null-move pruning (không dùng khi bị chiếu / chỉ còn vua + tốt)
+    bool lateMoveReductions = true;   // Giảm độ sâu các nước yên tĩnh xếp cuối
+    bool checkExtensions = true;      // Nước chiếu được search sâu thêm 1 ply
+};
+
+/**
+ * Trạng thái riêng của một thread search (Lazy SMP)
+ * Mỗi thread có bản copy GameState, undo stack, accumulator NNUE và killer/history riêng;
+ * chỉ TT (và weights NNUE chỉ đọc) là dùng chung
+ */
+struct SearchThread {
+    int id;                         // 0 = thread chính (quyết định nước đi, kiểm tra giới hạn)
+    GameState state;
+    MoveOrderer orderer;
+    NNUEStack nnue;                 // Accumulator theo ply, đi cùng applyMove/unmakeMove
+    std::atomic<long long> nodes;   // Thread khác chỉ đọc (báo cáo) => relaxed là đủ
+    bool aborted;                   // Thread này đã dừng, bỏ vòng đang search
+    
+    explicit SearchThread(int threadId)
+        : id(threadId), nnue(MoveOrderer::MAX_PLY), nodes(0), aborted(false) {}
+    
+    void countNode() { nodes.store(nodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+    long long nodeCount() const { return nodes.load(std::memory_order_relaxed); }
+    
+    /**
+     * Đi/hoàn tác nước trong search: cập nhật state và stack accumulator NNUE cùng lúc
+     */
+    void applyMove(const Move& move) {
+        nnue.push(state.getBoard(), move);
+        state.applyMove(move);
+    }
+    void unmakeMove() {
+        state.unmakeMove();
+        nnue.pop();
+    }
+    void applyNullMove() {
+        nnue.pushNull();
+        state.applyNullMove();
+    }
+    void unmakeNullMove() {
+        state.unmakeNullMove();
+        nnue.pop();
+    }
+};
+
+/**
+ * Class AI player: negamax principal variation search với alpha-beta pruning,
+ * null move, late move reductions, check extensions và aspiration windows ở gốc
+ * Tham khảo từ example.cpp nhưng refactor theo MVC
+ */
+class AIPlayer {
+public:
+    static const int MAX_SEARCH_DEPTH = 64;
+    
+    // Điểm chiếu hết tại gốc; mate sau n ply = MATE_SCORE - n
+    static const int MATE_SCORE = 32000;
+    // |điểm| >= MATE_BOUND => điểm mate (ply search không vượt quá MAX_PLY)
+    static const int MATE_BOUND = MATE_SCORE - MoveOrderer::MAX_PLY;
+    // Thắng chắc theo bitbase (chưa biết số nước tới mate), luôn nhỏ hơn MATE_BOUND
+    static const int KNOWN_WIN = 20000;
+    
+    // Lớn hơn mọi điểm search - cận alpha/beta ban đầu (đổi dấu không tràn như INT_MIN)
+    static const int INFINITE_SCORE = MATE_SCORE + 1;
+    
+    // Biên an toàn của delta pruning trong quiescence (2 tốt, centipawn)
+    static const int DELTA_MARGIN = 200;
+    
+    // Aspiration: nửa độ rộng cửa sổ ban đầu (centipawn), nhân đôi mỗi lần fail
+    static const int ASPIRATION_WINDOW = 25;
+    static const int ASPIRATION_MIN_DEPTH = 4;
+    
+    // Null move: độ sâu tối thiểu; từ NULL_VERIFY_DEPTH kiểm tra lại cutoff bằng search thường
+    static const int NULL_MOVE_MIN_DEPTH = 3;
+    static const int NULL_VERIFY_DEPTH = 10;
+    
+    // LMR: chỉ giảm từ độ sâu này, bỏ qua vài nước đầu (hash move, bắt quân tốt, killer)
+    static const int LMR_MIN_DEPTH = 3;
+    static const int LMR_FULL_MOVES = 3;
+
+private:
+    int searchDepth;  // Độ sâu tối đa của iterative deepening (3 = medium difficulty)
+    int timeLimitMs;        // Thời gian tối đa mỗi nước (0 = không giới hạn)
+    long long nodeLimit;    // Số node tối đa mỗi nước, tổng mọi thread (0 = không giới hạn)
+    
+    TranspositionTable tt;  // Giữ lại giữa các lượt đi, dùng chung cho mọi thread
+    
+    Evaluator evaluator;                    // Chọn lúc chạy, mặc định MATERIAL
+    std::unique_ptr<NNUENetwork> network;   // nullptr khi chưa load weights
+    
+    OpeningBook book;       // Polyglot book, tra trước khi search
+    bool useBook;
+    
+    Bitbases bitbases;      // Tàn cuộc 3-4 quân: cắt nhánh hòa, điểm lá cho nhánh thắng (chỉ đọc, dùng chung)
+    
+    SearchOptions searchOptions;
+    
+    // threads[0] = thread chính, còn lại là helper của Lazy SMP
+    std::vector<std::unique_ptr<SearchThread>> threads;
+    std::atomic<bool> helpersStop;  // Thread chính xong => helper dừng
+    
+    // Trạng thái của lượt search hiện tại
+    std::chrono::steady_clock::time_point searchStart;
+    std::function<void(const SearchInfo&)> infoCallback;
+    
+    // Search bất đồng bộ trên worker thread
+    std::thread worker;
+    std::atomic<bool> stopRequested;  // Yêu cầu dừng search (cancel)
+    std::atomic<bool> searchDone;     // Worker đã có kết quả
+    GameState searchState;            // Bản copy riêng của worker
+    Move searchResult;
+    
+    /**
+     * Đánh giá tĩnh vị trí hiện tại của thread (theo bên đang đi): material + piece-square tables,
+     * hoặc NNUE nếu được chọn và đã load weights; tàn cuộc có trong bitbase dùng bitbaseScore
+     * Không xét chiếu hết/hết nước - search tự phát hiện khi không còn nước đi
+     */
+    int evaluatePosition(SearchThread& thread);
+    
+    /**
+     * Điểm (theo bên đang đi) cho kết quả bitbase: hòa = 0, thắng = KNOWN_WIN + điểm tiến triển
+     * (material, đẩy tốt, dồn vua thua ra mép, hai vua lại gần) để search vẫn đi tới mate
+     */
+    int bitbaseScore(const GameState& state, BitbaseResult result) const;
+    
+    /**
+     * Negamax principal variation search với alpha-beta (điểm theo bên đang đi)
+     * Search tại chỗ trên state bằng applyMove/unmakeMove (không copy GameState,
+     * không kiểm tra lại move vì move lấy từ getLegalMoves của chính node đó)
+     * Tra transposition table trước khi search, lưu kết quả sau khi search
+     * Nước đi được thử theo thứ tự của MoveOrderer; null move / LMR / check extension theo searchOptions
+     * @param ply: khoảng cách tới gốc (chỉ số killer)
+     * @param allowNull: false ngay sau một null move (không null hai lần liên tiếp)
+     */
+    int negamax(SearchThread& thread, int depth, int ply, int alpha, int beta, bool allowNull);
+    
+    /**
+     * Quiescence search: ở node lá tiếp tục xét các nước bắt quân/phong cấp tới khi yên tĩnh
+     * Stand pat (không bắt gì) làm cận dưới; bỏ qua nước bắt không thể kéo điểm lên tới alpha
+     * Bị chiếu: không stand pat, xét mọi nước thoát chiếu, hết nước => điểm bị chiếu hết
+     */
+    int quiescence(SearchThread& thread, int ply, int alpha, int beta);
+    
+    /**
+     * Search tất cả nước đi gốc tới độ sâu depth trong cửa sổ (alpha, beta)
+     * @param bestMove: nhận nước tốt nhất đã search xong (kể cả khi bị cắt giữa chừng)
+     * @return điểm của bestMove theo bên đang đi (<= alpha / >= beta nếu fail low / high)
+     */
+    int searchRoot(SearchThread& thread, MoveList& moves, int depth, int alpha, int beta, Move& bestMove);
+    
+    /**
+     * Vòng iterative deepening của helper thread: chạy tới khi thread chính xong
+     */
+    void helperSearch(SearchThread& thread, MoveList moves);
+    
+    /**
+     * Kiểm tra giới hạn (hủy, node, thời gian); đặt thread.aborted nếu cần dừng
+     */
+    bool shouldStop(SearchThread& thread);
+    
+    /**
+     * Thời gian đã trôi qua từ đầu lượt search (ms)
+     */
+    int elapsedMs() const;
+
+public:
+    /**
+     * Constructor
+     * @param depth: độ sâu search tối đa (1-5 khi không đặt giới hạn thời gian, khuyến nghị 3)
+     */
+    AIPlayer(int depth = 3)
+        : searchDepth(depth), timeLimitMs(0), nodeLimit(0), evaluator(Evaluator::MATERIAL), useBook(false), helpersStop(false),
+          stopRequested(false), searchDone(false) {
+        setThreads(1);
+    }
+    
+    /**
+     * Destructor - hủy search đang chạy (nếu có) trước khi giải phóng
+     */
+    ~AIPlayer() { cancelSearch(); }
+    
+    AIPlayer(const AIPlayer&) = delete;
+    AIPlayer& operator=(const AIPlayer&) = delete;
+    
+    /**
+     * Lấy nước đi tốt nhất cho bên đang đi (iterative deepening tới searchDepth hoặc hết giới hạn)
+     * @param state: game state hiện tại, được khôi phục nguyên vẹn sau search
+     * @return nước đi tốt nhất của độ sâu hoàn tất gần nhất
+     */
+    Move getBestMove(GameState& state);
+    
+    /**
+     * Bắt đầu search trên worker thread (trả về ngay)
+     * Worker làm việc trên bản copy của state; hủy search cũ nếu còn chạy
+     */
+    void startSearch(const GameState& state);
+    
+    /**
+     * Có search đang chạy hoặc đang chờ lấy kết quả không
+     */
+    bool isSearching() const { return worker.joinable(); }
+    
+    /**
+     * Worker đã tìm xong nước đi chưa (poll mỗi frame)
+     */
+    bool isSearchDone() const { return searchDone.load(); }
+    
+    /**
+     * Lấy kết quả search (chờ worker kết thúc nếu chưa xong)
+     */
+    Move takeResult();
+    
+    /**
+     * Yêu cầu search đang chạy dừng sớm (UCI "stop"); không chờ
+     * takeResult() sau đó trả nước của độ sâu hoàn tất gần nhất
+     */
+    void stopSearch() { stopRequested = true; }
+    
+    /**
+     * Hủy search đang chạy; worker dừng ở node kế tiếp
+     */
+    void cancelSearch();
+    
+    /**
+     * Set độ khó (search depth tối đa)
+     */
+    void setDifficulty(int depth) { searchDepth = depth; }
+    
+    /**
+     * Giới hạn thời gian mỗi nước (ms, 0 = không giới hạn)
+     * Dùng cùng searchDepth lớn (MAX_SEARCH_DEPTH) để độ mạnh do thời gian quyết định
+     */
+    void setTimeLimit(int milliseconds) { timeLimitMs = milliseconds; }
+    
+    /**
+     * Giới hạn số node mỗi nước (0 = không giới hạn) - cho kết quả lặp lại được khi test
+     * Tính tổng mọi thread như getNodeCount(), kiểm tra mỗi 1024 node của thread chính
+     */
+    void setNodeLimit(long long maxNodes) { nodeLimit = maxNodes; }
+    
+    /**
+     * Callback gọi sau mỗi độ sâu hoàn tất (chạy trên thread đang search)
+     */
+    void setInfoCallback(std::function<void(const SearchInfo&)> callback) { infoCallback = callback; }
+    
+    /**
+     * Đặt dung lượng transposition table (MB); không gọi khi đang search
+     */
+    void setHashSize(std::size_t megabytes) { tt.resize(megabytes); }
+    
+    /**
+     * Load weights NNUE từ file (định dạng trong NNUE.h); không gọi khi đang search
+     * @return false nếu file lỗi - giữ nguyên mạng cũ (nếu có)
+     */
+    bool loadNetwork(const std::string& path);
+    
+    /**
+     * Chọn hàm đánh giá; NNUE chỉ có hiệu lực khi đã load weights
+     */
+    void setEvaluator(Evaluator type) { evaluator = type; }
+    
+    /**
+     * Hàm đánh giá đang thực sự dùng
+     */
+    Evaluator getEvaluator() const { return (evaluator == Evaluator::NNUE && network) ? Evaluator::NNUE : Evaluator::MATERIAL; }
+    
+    /**
+     * Mở opening book Polyglot (xem OpeningBook.h); không gọi khi đang search
+     */
+    bool loadOpeningBook(const std::string& bookPath) {
+        return book.open(bookPath);
+    }
+    
+    /**
+     * Bật/tắt tra book: vị trí có trong book thì trả nước book ngay, không search
+     */
+    void setUseBook(bool enabled) { useBook = enabled; }
+    
+    /**
+     * Map các file bitbase (.bb) trong directory; không gọi khi đang search
+     * @return số bảng đã mở
+     */
+    int loadBitbases(const std::string& directory) { return bitbases.load(directory); }
+    
+    /**
+     * Bật/tắt từng kỹ thuật search (mặc định bật hết); không gọi khi đang search
+     */
+    void setSearchOptions(const SearchOptions& options) { searchOptions = options; }
+    const SearchOptions& getSearchOptions() const { return searchOptions; }
+    
+    /**
+     * Xóa transposition table và history (vd. khi bắt đầu ván mới)
+     */
+    void clearHash();
+    
+    /**
+     * Số thread search (Lazy SMP, 1 = đơn luồng); không gọi khi đang search
+     */
+    void setThreads(int count);
+    
+    /**
+     * Số node đã duyệt trong lần search gần nhất (tổng mọi thread)
+     */
+    long long getNodeCount() const;
+};
@@ -0,0 +1,128 @@
+#include "Bitbase.h"
+
+#include <algorithm>
+#include <cstring>
+
+static const char PIECE_LETTERS[7] = {'?', 'P', 'N', 'B', 'R', 'Q', 'K'};
+
+std::string Bitbases::tableName(const std::vector<PieceType>& pieces) {
+    std::string name = "K";
+    for (PieceType type : pieces) {
+        name += PIECE_LETTERS[static_cast<int>(type)];
+    }
+    return name + "K";
+}
+
+bool Bitbases::parseName(const std::string& name, std::vector<PieceType>& pieces) {
+    pieces.clear();
+    if (name.size() < 3 || name.size() > 2 + MAX_EXTRA_PIECES || name.front() != 'K' || name.back() != 'K') {
+        return false;
+    }
+
+    for (std::size_t i = 1; i + 1 < name.size(); i++) {
+        const char* letter = std::strchr("PNBRQ", name[i]);
+        if (!letter || name[i] == '\0') return false;
+        pieces.push_back(static_cast<PieceType>(letter - "PNBRQ" + 1));
+    }
+
+    // Xếp Q, R, B, N, P (loại lớn trước)
+    std::sort(pieces.begin(), pieces.end(), [](PieceType a, PieceType b) {
+        return static_cast<int>(a) > static_cast<int>(b);
+    });
+    return true;
+}
+
+int Bitbases::load(const std::string& directory) {
+    static const PieceType types[5] = {
+        PieceType::QUEEN, PieceType::ROOK, PieceType::BISHOP, PieceType::KNIGHT, PieceType::PAWN
+    };
+    int loaded = 0;
+
+    // Thử mọi tổ hợp 1-2 quân (đã theo thứ tự Q, R, B, N, P)
+    for (int i = 0; i < 5; i++) {
+        for (int j = i - 1; j < 5; j++) {
+            std::vector<PieceType> pieces = {types[i]};
+            if (j >= i) pieces.push_back(types[j]);
+
+            std::unique_ptr<MappedFile> file(new MappedFile());
+            if (!file->open(directory + "/" + tableName(pieces) + ".bb")) continue;
+
+            // Kiểm tra header và kích thước
+            std::uint32_t header[4];
+            std::uint64_t expected = HEADER_SIZE + entryCount(static_cast<int>(pieces.size())) / 8;
+            if (file->size() != expected) continue;
+            std::memcpy(header, file->data(), sizeof(header));
+            if (std::memcmp(file->data(), "CGBB", 4) != 0 || header[1] != 1 || header[2] != pieces.size()) {
+                continue;
+            }
+
+            Table& table = tables[tableSlot(pieces.data(), static_cast<int>(pieces.size()))];
+            if (!table.bits) tableCount++;
+            table.bits = file->data() + HEADER_SIZE;
+            table.file = std::move(file);
+            loaded++;
+        }
+    }
+
+    return loaded;
+}
+
+void Bitbases::addTable(const std::vector<PieceType>& pieces, const std::uint8_t* bits) {
+    Table& table = tables[tableSlot(pieces.data(), static_cast<int>(pieces.size()))];
+    if (!table.bits) tableCount++;
+    table.file.reset();
+    table.bits = bits;
+}
+
+BitbaseResult Bitbases::probe(const Board& board, PieceColor sideToMove) const {
+    Bitboard occupied = board.occupied();
+    int total = popCount(occupied);
+    if (total < 3 || total > 2 + MAX_EXTRA_PIECES) return BitbaseResult::UNKNOWN;
+
+    // Bên yếu chỉ còn vua
+    PieceColor strong;
+    if (popCount(board.pieces(PieceColor::BLACK)) == 1) {
+        strong = PieceColor::WHITE;
+    } else if (popCount(board.pieces(PieceColor::WHITE)) == 1) {
+        strong = PieceColor::BLACK;
+    } else {
+        return BitbaseResult::UNKNOWN;
+    }
+    PieceColor weak = oppositeColor(strong);
+    int flip = (strong == PieceColor::WHITE) ? 0 : 56;  // Lật dọc để bên mạnh thành White
+
+    // Bàn thiếu vua (vị trí dựng tay): không có chỉ số hợp lệ, và quân thêm có thể vượt MAX_EXTRA_PIECES
+    int strongKing = board.kingSquare(strong);
+    int weakKing = board.kingSquare(weak);
+    if (strongKing < 0 || weakKing < 0) return BitbaseResult::UNKNOWN;
+
+    // Quân thêm của bên mạnh, loại lớn trước
+    int squares[MAX_EXTRA_PIECES] = {};
+    PieceType pieces[MAX_EXTRA_PIECES] = {};
+    Bitboard extras = board.pieces(strong) & ~board.pieces(PieceType::KING);
+    int count = 0;
+    while (extras) {
+        int square = popLsb(extras);
+        int type = static_cast<int>(board.typeAt(square));
+        int pos = count++;
+        while (pos > 0 && static_cast<int>(board.typeAt(squares[pos - 1] ^ flip)) < type) {
+            squares[pos] = squares[pos - 1];
+            pos--;
+        }
+        squares[pos] = square ^ flip;
+    }
+    for (int i = 0; i < count; i++) {
+        pieces[i] = board.typeAt(squares[i] ^ flip);
+    }
+    if (count == 0) return BitbaseResult::UNKNOWN;
+
+    const Table& table = tables[tableSlot(pieces, count)];
+    if (!table.bits) return BitbaseResult::UNKNOWN;
+
+    int stm = (sideToMove == strong) ? 0 : 1;
+    std::uint64_t idx = index(stm, strongKing ^ flip, weakKing ^ flip, squares, count);
+    bool strongWins = (table.bits[idx >> 3] >> (idx & 7)) & 1;
+
+    if (!strongWins) return BitbaseResult::DRAW;
+    return (stm == 0) ? BitbaseResult::WIN : BitbaseResult::LOSS;
+}
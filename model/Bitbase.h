@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "Board.h"
+#include "MappedFile.h"
+
+/**
+ * Kết quả tra bitbase, theo góc nhìn bên đang đi
+ */
+enum class BitbaseResult {
+    UNKNOWN,    // Không có bảng cho vị trí này
+    DRAW,
+    WIN,
+    LOSS
+};
+
+/**
+ * Bitbase thắng/hòa cho tàn cuộc 3-4 quân: vua + 1-2 quân (bên mạnh) đấu vua đơn (bên yếu)
+ * VD: KPK, KRK, KQK, KBNK. Bên mạnh luôn được chuẩn hóa thành White (lật bàn nếu là Black)
+ *
+ * Chỉ số: ((stm * 64 + vua mạnh) * 64 + vua yếu) * 64 + quân 1 [* 64 + quân 2]
+ *   stm = 0 nếu bên mạnh đang đi, 1 nếu bên yếu đang đi; quân xếp theo Q, R, B, N, P
+ * File "<tên>.bb": "CGBB", uint32 version = 1, uint32 số quân thêm, uint32 0, rồi 1 bit/chỉ số
+ * (bit = 1: bên mạnh thắng), sinh bởi tool bitbase
+ */
+class Bitbases {
+public:
+    static const int MAX_EXTRA_PIECES = 2;
+    static const std::size_t HEADER_SIZE = 16;
+
+    Bitbases() : tableCount(0) {}
+
+    /**
+     * Số chỉ số của bảng có extraPieces quân ngoài hai vua
+     */
+    static std::uint64_t entryCount(int extraPieces) {
+        return std::uint64_t(2) << (6 * (2 + extraPieces));
+    }
+
+    /**
+     * Tên bảng theo danh sách quân thêm (đã xếp Q, R, B, N, P), VD {BISHOP, KNIGHT} -> "KBNK"
+     */
+    static std::string tableName(const std::vector<PieceType>& pieces);
+
+    /**
+     * Tách tên bảng thành danh sách quân thêm (xếp lại theo Q, R, B, N, P)
+     * @return false nếu tên không hợp lệ
+     */
+    static bool parseName(const std::string& name, std::vector<PieceType>& pieces);
+
+    /**
+     * Chỉ số theo định nghĩa ở trên (ô đã chuẩn hóa cho bên mạnh là White)
+     */
+    static std::uint64_t index(int sideToMove, int strongKing, int weakKing, const int* squares, int count) {
+        std::uint64_t idx = (static_cast<std::uint64_t>(sideToMove) * 64 + strongKing) * 64 + weakKing;
+        for (int i = 0; i < count; i++) {
+            idx = idx * 64 + squares[i];
+        }
+        return idx;
+    }
+
+    /**
+     * Mở mọi bảng K[QRBNP]{1,2}K có trong directory
+     * @return số bảng đã mở
+     */
+    int load(const std::string& directory);
+
+    /**
+     * Dùng bảng nằm sẵn trong bộ nhớ (tool sinh bitbase tra bảng con khi đang sinh)
+     * bits phải sống lâu hơn đối tượng này
+     */
+    void addTable(const std::vector<PieceType>& pieces, const std::uint8_t* bits);
+
+    bool empty() const { return tableCount == 0; }
+
+    /**
+     * Tra vị trí (không xét castling/en passant - bên yếu chỉ có vua)
+     * @return UNKNOWN nếu không phải dạng vua đơn hoặc chưa có bảng
+     */
+    BitbaseResult probe(const Board& board, PieceColor sideToMove) const;
+
+private:
+    struct Table {
+        std::unique_ptr<MappedFile> file;  // nullptr với bảng trong bộ nhớ
+        const std::uint8_t* bits = nullptr;
+    };
+
+    // [loại quân 1 * 8 + loại quân 2 (0 nếu không có)] - tra trực tiếp, không so chuỗi
+    Table tables[64];
+    int tableCount;
+
+    static int tableSlot(const PieceType* pieces, int count) {
+        return static_cast<int>(pieces[0]) * 8 + (count > 1 ? static_cast<int>(pieces[1]) : 0);
+    }
+};
@@ -0,0 +1,169 @@
+#include "Bitboard.h"
+
+AttackTables::AttackTables() {
+    int knightOffsets[8][2] = {
+        {-2, -1}, {-2, 1}, {-1, -2}, {-1, 2},
+        {1, -2}, {1, 2}, {2, -1}, {2, 1}
+    };
+
+    for (int square = 0; square < 64; square++) {
+        Position pos = squareToPosition(square);
+        knight[square] = 0;
+        king[square] = 0;
+        pawn[0][square] = 0;
+        pawn[1][square] = 0;
+
+        for (int i = 0; i < 8; i++) {
+            Position to(pos.row + knightOffsets[i][0], pos.col + knightOffsets[i][1]);
+            if (to.isValid()) knight[square] |= squareBB(squareIndex(to));
+        }
+
+        for (int drow = -1; drow <= 1; drow++) {
+            for (int dcol = -1; dcol <= 1; dcol++) {
+                if (drow == 0 && dcol == 0) continue;
+                Position to(pos.row + drow, pos.col + dcol);
+                if (to.isValid()) king[square] |= squareBB(squareIndex(to));
+            }
+        }
+
+        // White đi lên (row giảm), Black đi xuống (row tăng)
+        for (int dcol : {-1, 1}) {
+            Position whiteTo(pos.row - 1, pos.col + dcol);
+            Position blackTo(pos.row + 1, pos.col + dcol);
+            if (whiteTo.isValid()) pawn[0][square] |= squareBB(squareIndex(whiteTo));
+            if (blackTo.isValid()) pawn[1][square] |= squareBB(squareIndex(blackTo));
+        }
+    }
+}
+
+/**
+ * Sinh tấn công theo tia (Xe/Tượng) với tập quân cản occupied
+ * Dừng lại ở quân cản đầu tiên (ô đó vẫn được tính là bị tấn công)
+ * Chậm - chỉ dùng để dựng bảng magic lúc khởi động
+ */
+static Bitboard rayAttacks(int square, Bitboard occupied, const int directions[4][2]) {
+    Bitboard attacks = 0;
+    int row = square >> 3;
+    int col = square & 7;
+
+    for (int i = 0; i < 4; i++) {
+        int r = row + directions[i][0];
+        int c = col + directions[i][1];
+
+        while (r >= 0 && r < 8 && c >= 0 && c < 8) {
+            Bitboard bb = squareBB(r * 8 + c);
+            attacks |= bb;
+            if (occupied & bb) break;  // Bị chặn
+            r += directions[i][0];
+            c += directions[i][1];
+        }
+    }
+
+    return attacks;
+}
+
+static const int ROOK_DIRECTIONS[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+static const int BISHOP_DIRECTIONS[4][2] = {{-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+
+#ifndef __BMI2__
+/**
+ * Xorshift PRNG với seed cố định theo hàng => bảng magic giống nhau mọi lần chạy
+ * (seed đã chọn sao cho tìm magic nhanh)
+ */
+static Bitboard nextRandom(Bitboard& state) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 2685821657736338717ULL;
+}
+#endif
+
+/**
+ * Mask các ô cản: tia tấn công trên bàn trống, bỏ các ô biên không nằm cùng hàng/cột với ô gốc
+ */
+static Bitboard relevantMask(int square, const int directions[4][2]) {
+    Bitboard rows0and7 = 0xFFULL | (0xFFULL << 56);
+    Bitboard colsAandH = 0x0101010101010101ULL | (0x0101010101010101ULL << 7);
+    Bitboard edges = (rows0and7 & ~(0xFFULL << (square & ~7))) |
+                     (colsAandH & ~(0x0101010101010101ULL << (square & 7)));
+    return rayAttacks(square, 0, directions) & ~edges;
+}
+
+static void initMagics(Bitboard* table, Magic magics[64], const int directions[4][2]) {
+    Bitboard occupancy[4096], reference[4096];
+    int size = 0;
+#ifndef __BMI2__
+    static const Bitboard rowSeeds[8] = {1776, 826, 1312, 2205, 739, 2078, 974, 30};
+    Bitboard seed = 0;
+    int epoch[4096] = {};
+    int attempt = 0;
+#endif
+
+    for (int square = 0; square < 64; square++) {
+        Magic& m = magics[square];
+        m.mask = relevantMask(square, directions);
+        m.shift = 64 - popCount(m.mask);
+        m.attacks = (square == 0) ? table : magics[square - 1].attacks + size;
+
+        // Duyệt mọi tập con của mask (Carry-Rippler) và lưu tấn công tương ứng
+        size = 0;
+        Bitboard subset = 0;
+        do {
+            occupancy[size] = subset;
+            reference[size] = rayAttacks(square, subset, directions);
+            size++;
+            subset = (subset - m.mask) & m.mask;
+        } while (subset);
+
+#ifdef __BMI2__
+        m.magic = 0;
+        for (int i = 0; i < size; i++) {
+            m.attacks[m.index(occupancy[i])] = reference[i];
+        }
+#else
+        // Thử số ngẫu nhiên thưa cho tới khi không có va chạm xấu
+        if ((square & 7) == 0) seed = rowSeeds[square >> 3];
+        for (int i = 0; i < size; ) {
+            do {
+                m.magic = nextRandom(seed) & nextRandom(seed) & nextRandom(seed);
+            } while (popCount((m.magic * m.mask) >> 56) < 6);
+
+            attempt++;
+            for (i = 0; i < size; i++) {
+                unsigned idx = m.index(occupancy[i]);
+                if (epoch[idx] < attempt) {
+                    epoch[idx] = attempt;
+                    m.attacks[idx] = reference[i];
+                } else if (m.attacks[idx] != reference[i]) {
+                    break;  // Va chạm với tấn công khác => thử magic khác
+                }
+            }
+        }
+#endif
+    }
+}
+
+SliderTables::SliderTables() {
+    initMagics(rookTable, rookMagics, ROOK_DIRECTIONS);
+    initMagics(bishopTable, bishopMagics, BISHOP_DIRECTIONS);
+}
+
+LineTables::LineTables() {
+    for (int a = 0; a < 64; a++) {
+        for (int b = 0; b < 64; b++) {
+            between[a][b] = 0;
+            line[a][b] = 0;
+            if (a == b) continue;
+
+            Bitboard ends = squareBB(a) | squareBB(b);
+
+            if (rookAttacks(a, 0) & squareBB(b)) {
+                line[a][b] = (rookAttacks(a, 0) & rookAttacks(b, 0)) | ends;
+                between[a][b] = rookAttacks(a, squareBB(b)) & rookAttacks(b, squareBB(a));
+            } else if (bishopAttacks(a, 0) & squareBB(b)) {
+                line[a][b] = (bishopAttacks(a, 0) & bishopAttacks(b, 0)) | ends;
+                between[a][b] = bishopAttacks(a, squareBB(b)) & bishopAttacks(b, squareBB(a));
+            }
+        }
+    }
+}
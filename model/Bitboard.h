@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstdint>
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+#include "Piece.h"
+#include "Position.h"
+
+/**
+ * Bitboard: tập hợp 64 ô bàn cờ biểu diễn bằng một số nguyên 64-bit
+ * Bit thứ i ứng với ô có index i = row * 8 + col (giống mảng 1D của Board)
+ * => a8 = 0, h8 = 7, a1 = 56, h1 = 63
+ */
+typedef std::uint64_t Bitboard;
+
+/**
+ * Chuyển Position sang index ô (0-63)
+ */
+inline int squareIndex(const Position& pos) {
+    return pos.row * 8 + pos.col;
+}
+
+/**
+ * Chuyển index ô (0-63) sang Position
+ */
+inline Position squareToPosition(int square) {
+    return Position(square >> 3, square & 7);
+}
+
+/**
+ * Bitboard chỉ chứa một ô
+ */
+inline Bitboard squareBB(int square) {
+    return 1ULL << square;
+}
+
+/**
+ * Đếm số bit 1 (số quân trong tập hợp)
+ */
+inline int popCount(Bitboard bb) {
+    return __builtin_popcountll(bb);
+}
+
+/**
+ * Index của bit thấp nhất (bb phải khác 0)
+ */
+inline int lsbIndex(Bitboard bb) {
+    return __builtin_ctzll(bb);
+}
+
+/**
+ * Lấy và xóa bit thấp nhất (dùng để duyệt qua các quân)
+ */
+inline int popLsb(Bitboard& bb) {
+    int square = lsbIndex(bb);
+    bb &= bb - 1;
+    return square;
+}
+
+/**
+ * Index màu cho các mảng theo màu: WHITE = 0, BLACK = 1
+ */
+inline int colorIndex(PieceColor color) {
+    return color == PieceColor::WHITE ? 0 : 1;
+}
+
+inline PieceColor oppositeColor(PieceColor color) {
+    return color == PieceColor::WHITE ? PieceColor::BLACK : PieceColor::WHITE;
+}
+
+/**
+ * Bảng tấn công tính sẵn cho các quân nhảy (Mã, Vua, Tốt)
+ */
+struct AttackTables {
+    Bitboard knight[64];
+    Bitboard king[64];
+    Bitboard pawn[2][64];  // [colorIndex][square] - các ô tốt ở square tấn công
+
+    AttackTables();
+};
+
+inline const AttackTables& attackTables() {
+    static const AttackTables tables;
+    return tables;
+}
+
+inline Bitboard knightAttacks(int square) { return attackTables().knight[square]; }
+inline Bitboard kingAttacks(int square) { return attackTables().king[square]; }
+inline Bitboard pawnAttacks(PieceColor color, int square) {
+    return attackTables().pawn[colorIndex(color)][square];
+}
+
+/**
+ * Thông tin magic cho một ô: tấn công = attacks[index(occupied)]
+ * mask: các ô cản có ảnh hưởng (bỏ ô biên cuối tia)
+ */
+struct Magic {
+    Bitboard mask;
+    Bitboard magic;
+    Bitboard* attacks;
+    unsigned shift;
+
+    unsigned index(Bitboard occupied) const {
+#ifdef __BMI2__
+        return static_cast<unsigned>(_pext_u64(occupied, mask));
+#else
+        return static_cast<unsigned>(((occupied & mask) * magic) >> shift);
+#endif
+    }
+};
+
+/**
+ * Bảng tấn công quân trượt (Xe, Tượng) tính sẵn bằng magic bitboard
+ * Dựng một lần lúc khởi động; khi build với BMI2 thì dùng PEXT làm index
+ */
+struct SliderTables {
+    Magic rookMagics[64];
+    Magic bishopMagics[64];
+    Bitboard rookTable[0x19000];   // Tổng số entry cho Xe (102400)
+    Bitboard bishopTable[0x1480];  // Tổng số entry cho Tượng (5248)
+
+    SliderTables();
+};
+
+inline const SliderTables& sliderTables() {
+    static const SliderTables tables;
+    return tables;
+}
+
+/**
+ * Tấn công của Xe/Tượng/Hậu tại square với tập quân cản occupied (tra bảng)
+ */
+inline Bitboard rookAttacks(int square, Bitboard occupied) {
+    const Magic& m = sliderTables().rookMagics[square];
+    return m.attacks[m.index(occupied)];
+}
+
+inline Bitboard bishopAttacks(int square, Bitboard occupied) {
+    const Magic& m = sliderTables().bishopMagics[square];
+    return m.attacks[m.index(occupied)];
+}
+
+inline Bitboard queenAttacks(int square, Bitboard occupied) {
+    return rookAttacks(square, occupied) | bishopAttacks(square, occupied);
+}
+
+/**
+ * Bảng đường thẳng giữa 2 ô (cùng hàng/cột/đường chéo), dùng cho pin và chặn chiếu
+ */
+struct LineTables {
+    Bitboard between[64][64];  // Các ô nằm giữa a và b (không gồm a, b); 0 nếu không thẳng hàng
+    Bitboard line[64][64];     // Cả đường thẳng qua a và b (từ biên tới biên); 0 nếu không thẳng hàng
+
+    LineTables();
+};
+
+inline const LineTables& lineTables() {
+    static const LineTables tables;
+    return tables;
+}
+
+inline Bitboard betweenBB(int a, int b) { return lineTables().between[a][b]; }
+inline Bitboard lineBB(int a, int b) { return lineTables().line[a][b]; }
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+#include "Piece.h"
+#include "Position.h"
+#include "Bitboard.h"
+#include "Zobrist.h"
+#include "Evaluation.h"
+
+/**
+ * Class đại diện cho bàn cờ vua 8x8
+ * Sử dụng mảng 1D để lưu trạng thái (ĐÁP ỨNG YÊU CẦU mảng 1D)
+ * Song song với mảng 1D là các bitboard theo loại quân và theo màu,
+ * ô vua và số quân từng loại, để MoveGenerator/GameState truy vấn trực tiếp thay vì quét 64 ô
+ */
+class Board {
+private:
+    std::uint8_t board[64];  // Mảng 1D chứa 64 ô bàn cờ (YÊU CẦU BẮT BUỘC) - mã quân 1 byte/ô (encodePiece)
+    
+    Bitboard byType[7];      // [PieceType] - ô có quân loại đó (cả 2 màu), [NONE] = mọi quân
+    Bitboard byColor[2];     // [colorIndex] - ô có quân của màu đó
+    
+    ZobristKey pieceKey;     // Phần Zobrist của quân trên bàn, cập nhật trong setPieceAt
+    
+    int kingSq[2];               // [colorIndex] - ô của vua, -1 nếu không có
+    std::uint8_t counts[24];     // [mã quân] - số quân mỗi loại/màu đang trên bàn
+    
+    int mgScore[2];          // [colorIndex] - tổng material + PST middlegame (EvalTables), cộng dồn
+    int egScore[2];          // [colorIndex] - tổng material + PST endgame
+    int phaseSum;            // Tổng trọng số phase của quân trên bàn
+    
+    /**
+     * Chuyển đổi Position 2D sang index 1D
+     * @param pos: vị trí (row, col)
+     * @return index trong mảng 1D (0-63)
+     */
+    int posToIndex(const Position& pos) const {
+        return pos.row * 8 + pos.col;
+    }
+    
+    /**
+     * Chuyển đổi index 1D sang Position 2D
+     * @param index: index trong mảng (0-63)
+     * @return Position (row, col)
+     */
+    Position indexToPos(int index) const {
+        return Position(index / 8, index % 8);
+    }
+
+public:
+    /**
+     * Constructor - khởi tạo bàn cờ rỗng
+     */
+    Board() {
+        clear();
+    }
+    
+    /**
+     * Lấy quân cờ tại vị trí cụ thể
+     * @param pos: vị trí cần lấy
+     * @return Piece tại vị trí đó
+     */
+    Piece getPiece(const Position& pos) const {
+        if (!pos.isValid()) return Piece();
+        return decodePiece(board[posToIndex(pos)]);
+    }
+    
+    /**
+     * Lấy quân cờ theo index ô (không kiểm tra biên, dùng trong engine)
+     */
+    Piece pieceAt(int square) const {
+        return decodePiece(board[square]);
+    }
+    
+    /**
+     * Mã quân tại ô (encodePiece), 0 = trống
+     */
+    std::uint8_t codeAt(int square) const {
+        return board[square];
+    }
+    
+    /**
+     * Lấy loại quân tại ô (không kiểm tra biên)
+     */
+    PieceType typeAt(int square) const {
+        return static_cast<PieceType>(board[square] & 7);
+    }
+    
+    /**
+     * Đặt quân cờ vào vị trí cụ thể
+     * @param pos: vị trí cần đặt
+     * @param piece: quân cờ cần đặt
+     */
+    void setPiece(const Position& pos, const Piece& piece) {
+        if (!pos.isValid()) return;
+        setPieceAt(posToIndex(pos), piece);
+    }
+    
+    /**
+     * Đặt quân cờ theo index ô, cập nhật mảng 1D và các bitboard
+     */
+    void setPieceAt(int square, const Piece& piece) {
+        Bitboard bb = squareBB(square);
+        
+        // Xóa quân cũ khỏi bitboard
+        std::uint8_t oldCode = board[square];
+        std::uint8_t newCode = encodePiece(piece);
+        const ZobristKeys& keys = zobristKeys();
+        const EvalTables& eval = evalTables();
+        pieceKey ^= keys.piece[oldCode][square] ^ keys.piece[newCode][square];
+        
+        if (oldCode != 0) {
+            int oldColor = colorIndex(static_cast<PieceColor>(oldCode >> 3));
+            byType[oldCode & 7] &= ~bb;
+            byType[0] &= ~bb;
+            byColor[oldColor] &= ~bb;
+            counts[oldCode]--;
+            if (kingSq[oldColor] == square) kingSq[oldColor] = -1;
+            
+            mgScore[oldColor] -= eval.mg[oldCode][square];
+            egScore[oldColor] -= eval.eg[oldCode][square];
+            phaseSum -= eval.phase[oldCode];
+        }
+        
+        board[square] = newCode;
+        
+        // Thêm quân mới
+        if (!piece.isEmpty()) {
+            int newColor = colorIndex(piece.color);
+            byType[static_cast<int>(piece.type)] |= bb;
+            byType[0] |= bb;
+            byColor[newColor] |= bb;
+            counts[newCode]++;
+            if (piece.type == PieceType::KING) kingSq[newColor] = square;
+            
+            mgScore[newColor] += eval.mg[newCode][square];
+            egScore[newColor] += eval.eg[newCode][square];
+            phaseSum += eval.phase[newCode];
+        }
+    }
+    
+    /**
+     * Bitboard tất cả quân trên bàn cờ
+     */
+    Bitboard occupied() const { return byType[0]; }
+    
+    /**
+     * Bitboard quân của một màu
+     */
+    Bitboard pieces(PieceColor color) const { return byColor[colorIndex(color)]; }
+    
+    /**
+     * Bitboard quân theo loại (cả 2 màu)
+     */
+    Bitboard pieces(PieceType type) const { return byType[static_cast<int>(type)]; }
+    
+    /**
+     * Bitboard quân theo loại và màu
+     */
+    Bitboard pieces(PieceType type, PieceColor color) const {
+        return byType[static_cast<int>(type)] & byColor[colorIndex(color)];
+    }
+    
+    /**
+     * Ô của vua một bên (-1 nếu bàn không có vua bên đó)
+     */
+    int kingSquare(PieceColor color) const { return kingSq[colorIndex(color)]; }
+    
+    /**
+     * Số quân theo loại và màu
+     */
+    int pieceCount(PieceType type, PieceColor color) const {
+        return counts[static_cast<int>(type) | (static_cast<int>(color) << 3)];
+    }
+    
+    /**
+     * Điểm material + PST của một bên, đã trộn middlegame/endgame theo phase hiện tại
+     */
+    int evalScore(PieceColor color) const {
+        int side = colorIndex(color);
+        return taperedScore(mgScore[side], egScore[side], phaseSum);
+    }
+    
+    /**
+     * Tính lại điểm tapered của một bên từ đầu (để kiểm tra bản cập nhật tăng dần)
+     */
+    int computeEvalScore(PieceColor color) const {
+        const EvalTables& eval = evalTables();
+        int mg = 0, eg = 0, phase = 0;
+        for (int i = 0; i < 64; i++) {
+            phase += eval.phase[board[i]];
+            if (board[i] != 0 && (board[i] >> 3) == static_cast<int>(color)) {
+                mg += eval.mg[board[i]][i];
+                eg += eval.eg[board[i]][i];
+            }
+        }
+        return taperedScore(mg, eg, phase);
+    }
+    
+    /**
+     * Khóa Zobrist của phần quân cờ (không gồm lượt/castling/en passant)
+     */
+    ZobristKey hash() const { return pieceKey; }
+    
+    /**
+     * Tính lại khóa quân cờ từ đầu (để kiểm tra bản cập nhật tăng dần)
+     */
+    ZobristKey computeHash() const {
+        ZobristKey key = 0;
+        for (int i = 0; i < 64; i++) {
+            key ^= zobristKeys().piece[board[i]][i];
+        }
+        return key;
+    }
+    
+    /**
+     * Xóa toàn bộ bàn cờ (đặt tất cả ô về rỗng)
+     */
+    void clear() {
+        for (int i = 0; i < 64; i++) {
+            board[i] = 0; // Empty piece
+        }
+        for (int i = 0; i < 7; i++) {
+            byType[i] = 0;
+        }
+        byColor[0] = byColor[1] = 0;
+        pieceKey = 0;
+        kingSq[0] = kingSq[1] = -1;
+        mgScore[0] = mgScore[1] = 0;
+        egScore[0] = egScore[1] = 0;
+        phaseSum = 0;
+        for (int i = 0; i < 24; i++) {
+            counts[i] = 0;
+        }
+    }
+    
+    /**
+     * Setup vị trí khởi đầu chuẩn của cờ vua
+     */
+    void setupInitialPosition();
+    
+    /**
+     * Export bàn cờ ra FEN (Forsyth-Edwards Notation) string
+     * VD: "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR"
+     * @return FEN string (chỉ phần board, không có turn/castling/etc)
+     */
+    std::string toFEN() const;
+    
+    /**
+     * Load bàn cờ từ FEN string
+     * @param fen: FEN string (chỉ phần board)
+     * @return true nếu load thành công
+     */
+    bool fromFEN(const std::string& fen);
+    
+    /**
+     * In bàn cờ ra console (để debug)
+     */
+    void print() const;
+};
@@ -0,0 +1,137 @@
+#include "Evaluation.h"
+#include "Piece.h"
+
+// Bảng viết theo góc nhìn White, hàng đầu tiên = hàng 8 (trùng thứ tự ô của Board)
+// Black dùng ô đối xứng dọc (square ^ 56)
+
+static const int PAWN_MG[64] = {
+     0,   0,   0,   0,   0,   0,   0,   0,
+    50,  50,  50,  50,  50,  50,  50,  50,
+    10,  10,  20,  30,  30,  20,  10,  10,
+     5,   5,  10,  25,  25,  10,   5,   5,
+     0,   0,   0,  20,  20,   0,   0,   0,
+     5,  -5, -10,   0,   0, -10,  -5,   5,
+     5,  10,  10, -20, -20,  10,  10,   5,
+     0,   0,   0,   0,   0,   0,   0,   0
+};
+
+static const int PAWN_EG[64] = {
+     0,   0,   0,   0,   0,   0,   0,   0,
+    80,  80,  80,  80,  80,  80,  80,  80,
+    50,  50,  50,  50,  50,  50,  50,  50,
+    30,  30,  30,  30,  30,  30,  30,  30,
+    20,  20,  20,  20,  20,  20,  20,  20,
+    10,  10,  10,  10,  10,  10,  10,  10,
+    10,  10,  10,  10,  10,  10,  10,  10,
+     0,   0,   0,   0,   0,   0,   0,   0
+};
+
+static const int KNIGHT_PST[64] = {
+   -50, -40, -30, -30, -30, -30, -40, -50,
+   -40, -20,   0,   0,   0,   0, -20, -40,
+   -30,   0,  10,  15,  15,  10,   0, -30,
+   -30,   5,  15,  20,  20,  15,   5, -30,
+   -30,   0,  15,  20,  20,  15,   0, -30,
+   -30,   5,  10,  15,  15,  10,   5, -30,
+   -40, -20,   0,   5,   5,   0, -20, -40,
+   -50, -40, -30, -30, -30, -30, -40, -50
+};
+
+static const int BISHOP_PST[64] = {
+   -20, -10, -10, -10, -10, -10, -10, -20,
+   -10,   0,   0,   0,   0,   0,   0, -10,
+   -10,   0,   5,  10,  10,   5,   0, -10,
+   -10,   5,   5,  10,  10,   5,   5, -10,
+   -10,   0,  10,  10,  10,  10,   0, -10,
+   -10,  10,  10,  10,  10,  10,  10, -10,
+   -10,   5,   0,   0,   0,   0,   5, -10,
+   -20, -10, -10, -10, -10, -10, -10, -20
+};
+
+static const int ROOK_MG[64] = {
+     0,   0,   0,   0,   0,   0,   0,   0,
+     5,  10,  10,  10,  10,  10,  10,   5,
+    -5,   0,   0,   0,   0,   0,   0,  -5,
+    -5,   0,   0,   0,   0,   0,   0,  -5,
+    -5,   0,   0,   0,   0,   0,   0,  -5,
+    -5,   0,   0,   0,   0,   0,   0,  -5,
+    -5,   0,   0,   0,   0,   0,   0,  -5,
+     0,   0,   0,   5,   5,   0,   0,   0
+};
+
+static const int ROOK_EG[64] = {
+     5,   5,   5,   5,   5,   5,   5,   5,
+    10,  10,  10,  10,  10,  10,  10,  10,
+     0,   0,   0,   0,   0,   0,   0,   0,
+     0,   0,   0,   0,   0,   0,   0,   0,
+     0,   0,   0,   0,   0,   0,   0,   0,
+     0,   0,   0,   0,   0,   0,   0,   0,
+     0,   0,   0,   0,   0,   0,   0,   0,
+     0,   0,   0,   0,   0,   0,   0,   0
+};
+
+static const int QUEEN_PST[64] = {
+   -20, -10, -10,  -5,  -5, -10, -10, -20,
+   -10,   0,   0,   0,   0,   0,   0, -10,
+   -10,   0,   5,   5,   5,   5,   0, -10,
+    -5,   0,   5,   5,   5,   5,   0,  -5,
+     0,   0,   5,   5,   5,   5,   0,  -5,
+   -10,   5,   5,   5,   5,   5,   0, -10,
+   -10,   0,   5,   0,   0,   0,   0, -10,
+   -20, -10, -10,  -5,  -5, -10, -10, -20
+};
+
+// Middlegame: vua trốn sau tốt ở góc đã nhập thành
+static const int KING_MG[64] = {
+   -30, -40, -40, -50, -50, -40, -40, -30,
+   -30, -40, -40, -50, -50, -40, -40, -30,
+   -30, -40, -40, -50, -50, -40, -40, -30,
+   -30, -40, -40, -50, -50, -40, -40, -30,
+   -20, -30, -30, -40, -40, -30, -30, -20,
+   -10, -20, -20, -20, -20, -20, -20, -10,
+    20,  20,   0,   0,   0,   0,  20,  20,
+    20,  30,  10,   0,   0,  10,  30,  20
+};
+
+// Endgame: vua lên trung tâm tham chiến
+static const int KING_EG[64] = {
+   -50, -40, -30, -20, -20, -30, -40, -50,
+   -30, -20, -10,   0,   0, -10, -20, -30,
+   -30, -10,  20,  30,  30,  20, -10, -30,
+   -30, -10,  30,  40,  40,  30, -10, -30,
+   -30, -10,  30,  40,  40,  30, -10, -30,
+   -30, -10,  20,  30,  30,  20, -10, -30,
+   -30, -30,   0,   0,   0,   0, -30, -30,
+   -50, -30, -30, -30, -30, -30, -30, -50
+};
+
+EvalTables::EvalTables() {
+    // [PieceType] - bảng middlegame/endgame và trọng số phase
+    const int* mgTables[7] = {nullptr, PAWN_MG, KNIGHT_PST, BISHOP_PST, ROOK_MG, QUEEN_PST, KING_MG};
+    const int* egTables[7] = {nullptr, PAWN_EG, KNIGHT_PST, BISHOP_PST, ROOK_EG, QUEEN_PST, KING_EG};
+    const int phaseWeights[7] = {0, 0, 1, 1, 2, 4, 0};
+
+    for (int code = 0; code < 24; code++) {
+        int type = code & 7;
+        int color = code >> 3;
+        bool valid = (type >= 1 && type <= 6) && (color == 1 || color == 2);
+
+        phase[code] = valid ? phaseWeights[type] : 0;
+
+        // Material lấy từ Piece::value (x10 => centipawn), vua không tính material
+        int material = 0;
+        if (valid && type != static_cast<int>(PieceType::KING)) {
+            material = Piece(static_cast<PieceType>(type), PieceColor::WHITE).value * 10;
+        }
+
+        for (int square = 0; square < 64; square++) {
+            if (!valid) {
+                mg[code][square] = eg[code][square] = 0;
+                continue;
+            }
+            int tableSquare = (color == static_cast<int>(PieceColor::WHITE)) ? square : (square ^ 56);
+            mg[code][square] = material + mgTables[type][tableSquare];
+            eg[code][square] = material + egTables[type][tableSquare];
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+/**
+ * Bảng đánh giá tĩnh theo ô (piece-square tables) có material gộp sẵn
+ * Hai bộ bảng: middlegame và endgame, trộn theo phase (số quân nhẹ/nặng còn lại)
+ * Đơn vị: centipawn (Tốt = 100 = Piece::value * 10)
+ * Board cộng dồn các giá trị này trong setPieceAt nên lá của search chỉ cần đọc tổng
+ */
+struct EvalTables {
+    int mg[24][64];     // [mã quân (type | color << 3)][ô] - material + PST middlegame, mã 0 = 0
+    int eg[24][64];     // [mã quân][ô] - material + PST endgame
+    int phase[24];      // [mã quân] - trọng số phase: Mã/Tượng 1, Xe 2, Hậu 4
+
+    EvalTables();
+};
+
+static const int MAX_PHASE = 24;  // Phase đầy đủ của vị trí khởi đầu
+
+inline const EvalTables& evalTables() {
+    static const EvalTables tables;
+    return tables;
+}
+
+/**
+ * Trộn điểm middlegame/endgame theo phase (phase >= MAX_PHASE => thuần middlegame)
+ */
+inline int taperedScore(int mg, int eg, int phase) {
+    if (phase > MAX_PHASE) phase = MAX_PHASE;
+    return (mg * phase + eg * (MAX_PHASE - phase)) / MAX_PHASE;
+}
@@ -1,532 +1,515 @@
-#include <vector>
-#include <string>
+#include "GameState.h"
+
 #include <sstream>
 #include <algorithm>
 #include <cstdlib>
+#include <cassert>
 
-/**
- * Class quản lý trạng thái game cờ vua
- * Bao gồm: board, turn, move history, captured pieces, castling rights, en passant
- */
-class GameState {
-private:
-    Board board;                          // Bàn cờ hiện tại
-    PieceColor currentTurn;               // Lượt đi hiện tại
-    std::vector<Move> moveHistory;        // Lịch sử nước đi (YÊU CẦU)
-    std::vector<Piece> capturedPieces;    // Quân bị bắt (YÊU CẦU)
-    
-    // Castling rights
-    bool whiteKingMoved;
-    bool blackKingMoved;
-    bool whiteRookKingSideMoved;
-    bool whiteRookQueenSideMoved;
-    bool blackRookKingSideMoved;
-    bool blackRookQueenSideMoved;
-    
-    // En passant target
-    Position enPassantTarget;
-    
-    // Move generator
-    MoveGenerator moveGenerator;
-    
-    /**
-     * Tìm vị trí vua của một bên
-     */
-    Position findKing(PieceColor color) const {
-        for (int row = 0; row < 8; row++) {
-            for (int col = 0; col < 8; col++) {
-                Position pos(row, col);
-                Piece piece = board.getPiece(pos);
-                
-                if (piece.type == PieceType::KING && piece.color == color) {
-                    return pos;
-                }
-            }
-        }
-        
-        return Position();
+ZobristKey GameState::enPassantKey(const Position& target, PieceColor capturer) const {
+    if (!target.isValid()) return 0;
+    
+    // Tốt capturer đứng ở ô mà tốt đối phương từ target sẽ tấn công
+    int square = squareIndex(target);
+    if (!(pawnAttacks(oppositeColor(capturer), square) & board.pieces(PieceType::PAWN, capturer))) {
+        return 0;
     }
+    return zobristKeys().enPassant[target.col];
+}
+
+ZobristKey GameState::computeStateKey() const {
+    const ZobristKeys& keys = zobristKeys();
+    ZobristKey key = keys.castling[castlingRights()] ^ enPassantKey(enPassantTarget, currentTurn);
+    if (currentTurn == PieceColor::BLACK) key ^= keys.side;
+    return key;
+}
+
+Position GameState::findKing(PieceColor color) const {
+    int square = board.kingSquare(color);
+    if (square < 0) return Position();
     
-    /**
-     * Kiểm tra một ô có bị tấn công bởi bên địch không
-     */
-    bool isSquareAttacked(const Position& pos, PieceColor byColor) const {
-        // Check pawn attacks
-        int pawnDir = (byColor == PieceColor::WHITE) ? 1 : -1;
-        for (int dcol : {-1, 1}) {
-            Position pawnPos(pos.row + pawnDir, pos.col + dcol);
-            if (pawnPos.isValid()) {
-                Piece piece = board.getPiece(pawnPos);
-                if (piece.type == PieceType::PAWN && piece.color == byColor) {
-                    return true;
-                }
-            }
-        }
-        
-        // Check knight attacks
-        int knightMoves[8][2] = {
-            {-2, -1}, {-2, 1}, {-1, -2}, {-1, 2},
-            {1, -2}, {1, 2}, {2, -1}, {2, 1}
-        };
-        for (int i = 0; i < 8; i++) {
-            Position knightPos(pos.row + knightMoves[i][0], pos.col + knightMoves[i][1]);
-            if (knightPos.isValid()) {
-                Piece piece = board.getPiece(knightPos);
-                if (piece.type == PieceType::KNIGHT && piece.color == byColor) {
-                    return true;
-                }
-            }
-        }
-        
-        // Check king attacks
-        for (int drow = -1; drow <= 1; drow++) {
-            for (int dcol = -1; dcol <= 1; dcol++) {
-                if (drow == 0 && dcol == 0) continue;
-                Position kingPos(pos.row + drow, pos.col + dcol);
-                if (kingPos.isValid()) {
-                    Piece piece = board.getPiece(kingPos);
-                    if (piece.type == PieceType::KING && piece.color == byColor) {
-                        return true;
-                    }
-                }
-            }
-        }
-        
-        // Check sliding pieces (Rook, Bishop, Queen)
-        int rookDirections[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
-        for (int i = 0; i < 4; i++) {
-            int drow = rookDirections[i][0];
-            int dcol = rookDirections[i][1];
-            Position current = pos;
-            
-            while (true) {
-                current.row += drow;
-                current.col += dcol;
-                if (!current.isValid()) break;
-                
-                Piece piece = board.getPiece(current);
-                if (!piece.isEmpty()) {
-                    if (piece.color == byColor && 
-                        (piece.type == PieceType::ROOK || piece.type == PieceType::QUEEN)) {
-                        return true;
-                    }
-                    break; // Bị chặn
-                }
-            }
-        }
-        
-        // Check diagonal (Bishop, Queen)
-        int bishopDirections[4][2] = {{-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
-        for (int i = 0; i < 4; i++) {
-            int drow = bishopDirections[i][0];
-            int dcol = bishopDirections[i][1];
-            Position current = pos;
-            
-            while (true) {
-                current.row += drow;
-                current.col += dcol;
-                if (!current.isValid()) break;
-                
-                Piece piece = board.getPiece(current);
-                if (!piece.isEmpty()) {
-                    if (piece.color == byColor && 
-                        (piece.type == PieceType::BISHOP || piece.type == PieceType::QUEEN)) {
-                        return true;
-                    }
-                    break;
-                }
-            }
-        }
-        
-        return false;
+    return squareToPosition(square);
+}
+
+bool GameState::isSquareAttacked(const Position& pos, PieceColor byColor) const {
+    int square = squareIndex(pos);
+    
+    // Check pawn attacks (tốt địch đứng ở ô mà tốt phe mình từ square sẽ tấn công)
+    if (pawnAttacks(oppositeColor(byColor), square) & board.pieces(PieceType::PAWN, byColor)) {
+        return true;
     }
     
-    /**
-     * Apply move lên board (không kiểm tra tính hợp lệ)
-     */
-    void applyMoveInternal(const Move& move) {
-        Piece movingPiece = board.getPiece(move.from);
-        
-        // Handle castling
-        if (move.moveType == MoveType::CASTLE_KINGSIDE) {
-            board.setPiece(move.to, movingPiece);
-            board.setPiece(move.from, Piece());
-            
-            int row = move.from.row;
-            Piece rook = board.getPiece(Position(row, 7));
-            board.setPiece(Position(row, 5), rook);
-            board.setPiece(Position(row, 7), Piece());
-            return;
-        }
-        
-        if (move.moveType == MoveType::CASTLE_QUEENSIDE) {
-            board.setPiece(move.to, movingPiece);
-            board.setPiece(move.from, Piece());
-            
-            int row = move.from.row;
-            Piece rook = board.getPiece(Position(row, 0));
-            board.setPiece(Position(row, 3), rook);
-            board.setPiece(Position(row, 0), Piece());
-            return;
-        }
-        
-        // Handle en passant
-        if (move.moveType == MoveType::EN_PASSANT) {
-            board.setPiece(move.to, movingPiece);
-            board.setPiece(move.from, Piece());
-            
-            int capturedRow = move.from.row;
-            int capturedCol = move.to.col;
-            board.setPiece(Position(capturedRow, capturedCol), Piece());
-            return;
-        }
-        
-        // Xử lý promotion
-        if (move.moveType == MoveType::PROMOTION) {
-            Piece promotedPiece(move.promotionPiece, movingPiece.color);
-            board.setPiece(move.to, promotedPiece);
-            board.setPiece(move.from, Piece());
-            return;
-        }
-        
-        // Normal move
-        board.setPiece(move.to, movingPiece);
-        board.setPiece(move.from, Piece());
+    // Check knight attacks
+    if (knightAttacks(square) & board.pieces(PieceType::KNIGHT, byColor)) {
+        return true;
+    }
+    
+    // Check king attacks
+    if (kingAttacks(square) & board.pieces(PieceType::KING, byColor)) {
+        return true;
+    }
+    
+    Bitboard occupied = board.occupied();
+    Bitboard queens = board.pieces(PieceType::QUEEN, byColor);
+    
+    // Check sliding pieces (Rook, Queen)
+    if (rookAttacks(square, occupied) & (board.pieces(PieceType::ROOK, byColor) | queens)) {
+        return true;
+    }
+    
+    // Check diagonal (Bishop, Queen)
+    if (bishopAttacks(square, occupied) & (board.pieces(PieceType::BISHOP, byColor) | queens)) {
+        return true;
     }
+    
+    return false;
+}
 
-public:
-    /**
-     * Constructor
-     */
-    GameState() : moveGenerator(board) {
-        reset();
+void GameState::applyMoveInternal(const Move& move) {
+    int from = move.fromSquare();
+    int to = move.toSquare();
+    Piece movingPiece = board.pieceAt(from);
+    
+    // Handle castling
+    if (move.moveType() == MoveType::CASTLE_KINGSIDE) {
+        board.setPieceAt(to, movingPiece);
+        board.setPieceAt(from, Piece());
+        
+        int rowStart = from & ~7;
+        Piece rook = board.pieceAt(rowStart + 7);
+        board.setPieceAt(rowStart + 5, rook);
+        board.setPieceAt(rowStart + 7, Piece());
+        return;
     }
     
-    /**
-     * Reset game về trạng thái khởi đầu
-     */
-    void reset() {
-        board.setupInitialPosition();
-        currentTurn = PieceColor::WHITE;
-        moveHistory.clear();
-        capturedPieces.clear();
-        
-        // Reset castling rights
-        whiteKingMoved = false;
-        blackKingMoved = false;
-        whiteRookKingSideMoved = false;
-        whiteRookQueenSideMoved = false;
-        blackRookKingSideMoved = false;
-        blackRookQueenSideMoved = false;
-        
-        // Reset en passant
-        enPassantTarget = Position(); // Invalid position
+    if (move.moveType() == MoveType::CASTLE_QUEENSIDE) {
+        board.setPieceAt(to, movingPiece);
+        board.setPieceAt(from, Piece());
+        
+        int rowStart = from & ~7;
+        Piece rook = board.pieceAt(rowStart);
+        board.setPieceAt(rowStart + 3, rook);
+        board.setPieceAt(rowStart, Piece());
+        return;
     }
     
-    /**
-     * Lấy board hiện tại (const)
-     */
-    const Board& getBoard() const { return board; }
-    
-    /**
-     * Lấy lượt đi hiện tại
-     */
-    PieceColor getCurrentTurn() const { return currentTurn; }
-    
-    /**
-     * Lấy lịch sử nước đi
-     */
-    const std::vector<Move>& getMoveHistory() const { return moveHistory; }
-    
-    /**
-     * Lấy danh sách quân bị bắt
-     */
-    const std::vector<Piece>& getCapturedPieces() const { return capturedPieces; }
-    
-    /**
-     * Lấy en passant target
-     */
-    Position getEnPassantTarget() const { return enPassantTarget; }
-    
-    /**
-     * Sinh tất cả legal moves cho bên đang đi
-     * (Lọc ra moves khiến vua bị chiếu)
-     */
-    std::vector<Move> getLegalMoves() {
-        // Sinh pseudo-legal moves
-        std::vector<Move> pseudoMoves = moveGenerator.generateMoves(
-            currentTurn, enPassantTarget,
-            whiteKingMoved, blackKingMoved,
-            whiteRookKingSideMoved, whiteRookQueenSideMoved,
-            blackRookKingSideMoved, blackRookQueenSideMoved
-        );
-        
-        std::vector<Move> legalMoves;
-        
-        // Lọc ra moves không khiến vua bị chiếu
-        for (const Move& move : pseudoMoves) {
-            // Thử move
-            Piece capturedPiece = board.getPiece(move.to);
-            applyMoveInternal(move);
-            
-            // Kiểm tra vua có bị chiếu không
-            bool inCheck = isInCheck(currentTurn);
-            
-            // Undo move
-            board.setPiece(move.from, board.getPiece(move.to));
-            board.setPiece(move.to, capturedPiece);
+    // Handle en passant
+    if (move.moveType() == MoveType::EN_PASSANT) {
+        board.setPieceAt(to, movingPiece);
+        board.setPieceAt(from, Piece());
+        
+        // Tốt bị bắt: cùng hàng ô xuất phát, cùng cột ô đích
+        board.setPieceAt((from & ~7) | (to & 7), Piece());
+        return;
+    }
+    
+    // Xử lý promotion
+    if (move.moveType() == MoveType::PROMOTION) {
+        Piece promotedPiece(move.promotionPiece(), movingPiece.color);
+        board.setPieceAt(to, promotedPiece);
+        board.setPieceAt(from, Piece());
+        return;
+    }
+    
+    // Normal move
+    board.setPieceAt(to, movingPiece);
+    board.setPieceAt(from, Piece());
+}
+
+void GameState::undoMoveInternal(const Move& move, const Piece& capturedPiece) {
+    int from = move.fromSquare();
+    int to = move.toSquare();
+    
+    Piece movedPiece = board.pieceAt(to);
+    if (move.moveType() == MoveType::PROMOTION) {
+        movedPiece = Piece(PieceType::PAWN, movedPiece.color);
+    }
+    
+    board.setPieceAt(from, movedPiece);
+    
+    if (move.moveType() == MoveType::EN_PASSANT) {
+        board.setPieceAt(to, Piece());
+        board.setPieceAt((from & ~7) | (to & 7), capturedPiece);
+    } else {
+        board.setPieceAt(to, capturedPiece);
+    }
+    
+    // Đưa xe về chỗ cũ nếu là castling
+    int rowStart = from & ~7;
+    if (move.moveType() == MoveType::CASTLE_KINGSIDE) {
+        board.setPieceAt(rowStart + 7, board.pieceAt(rowStart + 5));
+        board.setPieceAt(rowStart + 5, Piece());
+    } else if (move.moveType() == MoveType::CASTLE_QUEENSIDE) {
+        board.setPieceAt(rowStart, board.pieceAt(rowStart + 3));
+        board.setPieceAt(rowStart + 3, Piece());
+    }
+}
+
+void GameState::copyFrom(const GameState& other) {
+    board = other.board;
+    currentTurn = other.currentTurn;
+    moveHistory = other.moveHistory;
+    capturedPieces = other.capturedPieces;
+    moveHistory.reserve(moveHistory.size() + 256);   // Chỗ cho search trên bản copy
+    capturedPieces.reserve(32);
+    whiteKingMoved = other.whiteKingMoved;
+    blackKingMoved = other.blackKingMoved;
+    whiteRookKingSideMoved = other.whiteRookKingSideMoved;
+    whiteRookQueenSideMoved = other.whiteRookQueenSideMoved;
+    blackRookKingSideMoved = other.blackRookKingSideMoved;
+    blackRookQueenSideMoved = other.blackRookQueenSideMoved;
+    enPassantTarget = other.enPassantTarget;
+    stateKey = other.stateKey;
+    undoStack = other.undoStack;
+    undoStack.reserve(undoStack.size() + 256);
+    halfmoveClock = other.halfmoveClock;
+    fullmoveNumber = other.fullmoveNumber;
+    keyHistory = other.keyHistory;
+    keyHistory.reserve(keyHistory.size() + 256);
+}
+
+void GameState::reset() {
+    board.setupInitialPosition();
+    currentTurn = PieceColor::WHITE;
+    moveHistory.clear();
+    capturedPieces.clear();
+    undoStack.clear();
+    keyHistory.clear();
+    halfmoveClock = 0;
+    fullmoveNumber = 1;
+    
+    // Reset castling rights
+    whiteKingMoved = false;
+    blackKingMoved = false;
+    whiteRookKingSideMoved = false;
+    whiteRookQueenSideMoved = false;
+    blackRookKingSideMoved = false;
+    blackRookQueenSideMoved = false;
+    
+    // Reset en passant
+    enPassantTarget = Position(); // Invalid position
+    
+    stateKey = computeStateKey();
+}
+
+MoveList GameState::getLegalMoves() {
+    // MoveGenerator sinh thẳng nước hợp lệ (pin/check mask), không cần lọc
+    MoveList moves;
+    moveGenerator.generateMoves(
+        moves,
+        currentTurn, enPassantTarget,
+        whiteKingMoved, blackKingMoved,
+        whiteRookKingSideMoved, whiteRookQueenSideMoved,
+        blackRookKingSideMoved, blackRookQueenSideMoved
+    );
+    
+    return moves;
+}
+
+MoveList GameState::getLegalCaptures() {
+    MoveList moves;
+    moveGenerator.generateCaptures(moves, currentTurn, enPassantTarget);
+    return moves;
+}
+
+bool GameState::makeMove(const Move& move) {
+    // Kiểm tra move có hợp lệ không
+    MoveList legalMoves = getLegalMoves();
+    
+    for (const Move& legalMove : legalMoves) {
+        if (legalMove.fromSquare() == move.fromSquare() && legalMove.toSquare() == move.toSquare() &&
+            !move.isNull()) {
+            Move resolved = legalMove;
             
-            // Undo castling
-            if (move.moveType == MoveType::CASTLE_KINGSIDE) {
-                int row = move.from.row;
-                board.setPiece(Position(row, 7), board.getPiece(Position(row, 5)));
-                board.setPiece(Position(row, 5), Piece());
-            } else if (move.moveType == MoveType::CASTLE_QUEENSIDE) {
-                int row = move.from.row;
-                board.setPiece(Position(row, 0), board.getPiece(Position(row, 3)));
-                board.setPiece(Position(row, 3), Piece());
-            } else if (move.moveType == MoveType::EN_PASSANT) {
-                int capturedRow = move.from.row;
-                board.setPiece(Position(capturedRow, move.to.col), move.capturedPiece);
+            // Giữ quân phong cấp mà người chơi đã chọn
+            if (resolved.moveType() == MoveType::PROMOTION &&
+                move.promotionPiece() != PieceType::NONE) {
+                resolved.setPromotionPiece(move.promotionPiece());
             }
             
-            // Nếu không bị chiếu, move hợp lệ
-            if (!inCheck) {
-                // Kiểm tra thêm cho castling: không đi qua ô bị chiếu
-                if (move.moveType == MoveType::CASTLE_KINGSIDE || 
-                    move.moveType == MoveType::CASTLE_QUEENSIDE) {
-                    // Vua không được đang bị chiếu
-                    if (isInCheck(currentTurn)) continue;
-                    
-                    // Kiểm tra ô giữa không bị tấn công
-                    int row = move.from.row;
-                    PieceColor enemyColor = (currentTurn == PieceColor::WHITE) ? PieceColor::BLACK : PieceColor::WHITE;
-                    
-                    if (move.moveType == MoveType::CASTLE_KINGSIDE) {
-                        if (isSquareAttacked(Position(row, 5), enemyColor)) continue;
-                    } else {
-                        if (isSquareAttacked(Position(row, 3), enemyColor)) continue;
-                    }
-                }
-                
-                legalMoves.push_back(move);
-            }
+            applyMove(resolved);
+            return true;
         }
-        
-        return legalMoves;
     }
     
-    /**
-     * Thực hiện nước đi
-     * @param move: nước đi cần thực hiện
-     * @return true nếu thành công, false nếu không hợp lệ
-     */
-    bool makeMove(const Move& move) {
-        // Kiểm tra move có hợp lệ không
-        std::vector<Move> legalMoves = getLegalMoves();
-        bool isLegal = false;
-        
-        for (const Move& legalMove : legalMoves) {
-            if (legalMove.from == move.from && legalMove.to == move.to) {
-                isLegal = true;
-                break;
-            }
-        }
-        
-        if (!isLegal) return false;
-        
-        // Lưu quân bị bắt
-        Piece capturedPiece = board.getPiece(move.to);
-        if (!capturedPiece.isEmpty()) {
-            capturedPieces.push_back(capturedPiece);
-        }
-        
-        // Lưu lại nếu là en passant
-        if (move.moveType == MoveType::EN_PASSANT && !move.capturedPiece.isEmpty()) {
-            capturedPieces.push_back(move.capturedPiece);
-        }
-        
-        // Apply move
-        Piece movingPiece = board.getPiece(move.from);
-        applyMoveInternal(move);
-        
-        // Cập nhật castling rights
-        if (movingPiece.type == PieceType::KING) {
-            if (movingPiece.color == PieceColor::WHITE) whiteKingMoved = true;
-            else blackKingMoved = true;
-        }
-        if (movingPiece.type == PieceType::ROOK) {
-            if (movingPiece.color == PieceColor::WHITE) {
-                if (move.from == Position(7, 0)) whiteRookQueenSideMoved = true;
-                if (move.from == Position(7, 7)) whiteRookKingSideMoved = true;
-            } else {
-                if (move.from == Position(0, 0)) blackRookQueenSideMoved = true;
-                if (move.from == Position(0, 7)) blackRookKingSideMoved = true;
-            }
-        }
-        
-        // Cập nhật en passant target
-        if (movingPiece.type == PieceType::PAWN) {
-            int rowDiff = abs(move.to.row - move.from.row);
-            if (rowDiff == 2) {
-                // Pawn di chuyển 2 ô, set en passant target
-                int targetRow = (move.from.row + move.to.row) / 2;
-                enPassantTarget = Position(targetRow, move.from.col);
-            } else {
-                enPassantTarget = Position(); // Invalid
-            }
+    return false;
+}
+
+void GameState::applyMove(const Move& move) {
+    // Lưu trạng thái để unmakeMove
+    UndoInfo undo;
+    undo.move = move;
+    undo.capturedPiece = (move.moveType() == MoveType::EN_PASSANT)
+        ? Piece(PieceType::PAWN, oppositeColor(currentTurn))
+        : board.pieceAt(move.toSquare());
+    undo.castlingFlags = packCastlingFlags();
+    undo.enPassantTarget = enPassantTarget;
+    undo.stateKey = stateKey;
+    undo.halfmoveClock = halfmoveClock;
+    undoStack.push_back(undo);
+    keyHistory.push_back(hash());
+    
+    // Bỏ castling/en passant cũ khỏi hash (trước khi board thay đổi)
+    const ZobristKeys& keys = zobristKeys();
+    stateKey ^= keys.castling[castlingRights()] ^ enPassantKey(enPassantTarget, currentTurn);
+    
+    // Lưu quân bị bắt
+    if (!undo.capturedPiece.isEmpty()) {
+        capturedPieces.push_back(undo.capturedPiece);
+    }
+    
+    // Apply move
+    int from = move.fromSquare();
+    int to = move.toSquare();
+    Piece movingPiece = board.pieceAt(from);
+    applyMoveInternal(move);
+    
+    // Cập nhật castling rights (ô góc: a8 = 0, h8 = 7, a1 = 56, h1 = 63)
+    if (movingPiece.type == PieceType::KING) {
+        if (movingPiece.color == PieceColor::WHITE) whiteKingMoved = true;
+        else blackKingMoved = true;
+    }
+    if (movingPiece.type == PieceType::ROOK) {
+        if (movingPiece.color == PieceColor::WHITE) {
+            if (from == 56) whiteRookQueenSideMoved = true;
+            if (from == 63) whiteRookKingSideMoved = true;
         } else {
-            enPassantTarget = Position();
+            if (from == 0) blackRookQueenSideMoved = true;
+            if (from == 7) blackRookKingSideMoved = true;
         }
-        
-        // Thêm vào history
-        moveHistory.push_back(move);
-        
-        // Đổi lượt
-        currentTurn = (currentTurn == PieceColor::WHITE) ? PieceColor::BLACK : PieceColor::WHITE;
-        
-        return true;
     }
     
-    /**
-     * Kiểm tra vua có bị chiếu không
-     * @param color: màu của bên cần kiểm tra
-     * @return true nếu bị chiếu
-     */
-    bool isInCheck(PieceColor color) const {
-        Position kingPos = findKing(color);
-        if (!kingPos.isValid()) return false;
-        
-        PieceColor enemyColor = (color == PieceColor::WHITE) ? PieceColor::BLACK : PieceColor::WHITE;
-        return isSquareAttacked(kingPos, enemyColor);
+    // Xe bị bắt tại góc => mất quyền castling phía đó
+    if (undo.capturedPiece.type == PieceType::ROOK) {
+        if (to == 56) whiteRookQueenSideMoved = true;
+        if (to == 63) whiteRookKingSideMoved = true;
+        if (to == 0) blackRookQueenSideMoved = true;
+        if (to == 7) blackRookKingSideMoved = true;
     }
     
-    /**
-     * Kiểm tra checkmate
-     * @param color: màu của bên cần kiểm tra
-     * @return true nếu bị chiếu hết
-     */
-    bool isCheckmate(PieceColor color) const {
-        // Phải đang bị chiếu VÀ không có nước đi hợp lệ
-        if (!isInCheck(color)) return false;
-        
-        // Tạm thời thay đổi turn để getLegalMoves
-        GameState* mutableThis = const_cast<GameState*>(this);
-        PieceColor savedTurn = mutableThis->currentTurn;
-        mutableThis->currentTurn = color;
-        std::vector<Move> legalMoves = mutableThis->getLegalMoves();
-        mutableThis->currentTurn = savedTurn;
-        
-        return legalMoves.empty();
+    // Cập nhật en passant target
+    if (movingPiece.type == PieceType::PAWN && abs(to - from) == 16) {
+        // Pawn di chuyển 2 ô, set en passant target (ô ở giữa)
+        enPassantTarget = squareToPosition((from + to) / 2);
+    } else {
+        enPassantTarget = Position(); // Invalid
     }
     
-    /**
-     * Kiểm tra stalemate (hòa cờ)
-     * @param color: màu của bên cần kiểm tra
-     * @return true nếu hòa
-     */
-    bool isStalemate(PieceColor color) const {
-        // KHÔNG bị chiếu NHƯNG không có nước đi hợp lệ
-        if (isInCheck(color)) return false;
-        
-        // Tạm thời thay đổi turn để getLegalMoves
-        GameState* mutableThis = const_cast<GameState*>(this);
-        PieceColor savedTurn = mutableThis->currentTurn;
-        mutableThis->currentTurn = color;
-        std::vector<Move> legalMoves = mutableThis->getLegalMoves();
-        mutableThis->currentTurn = savedTurn;
-        
-        return legalMoves.empty();
+    // Thêm vào history
+    moveHistory.push_back(move);
+    
+    // Bắt quân / đi tốt không thể lặp lại vị trí trước đó
+    if (movingPiece.type == PieceType::PAWN || !undo.capturedPiece.isEmpty()) {
+        halfmoveClock = 0;
+    } else {
+        halfmoveClock++;
+    }
+    if (currentTurn == PieceColor::BLACK) {
+        fullmoveNumber++;
     }
     
-    /**
-     * Tính tổng giá trị material của một bên
-     * (YÊU CẦU: phép tính +, ảnh hưởng đầu ra)
-     * @param color: màu của bên cần tính
-     * @return tổng điểm
-     */
-    int calculateMaterialValue(PieceColor color) const {
-        int total = 0;
-        
-        // Duyệt qua bàn cờ, cộng giá trị quân của bên này
-        for (int i = 0; i < 64; i++) {
-            Position pos(i / 8, i % 8);
-            Piece piece = board.getPiece(pos);
-            
-            if (piece.color == color) {
-                total += piece.value;  // Phép cộng (+) - YÊU CẦU
-            }
-        }
-        
-        return total;
+    // Đổi lượt
+    currentTurn = (currentTurn == PieceColor::WHITE) ? PieceColor::BLACK : PieceColor::WHITE;
+    
+    // Thêm castling/en passant mới và đổi lượt vào hash
+    stateKey ^= keys.castling[castlingRights()] ^ enPassantKey(enPassantTarget, currentTurn) ^ keys.side;
+    assert(hash() == computeHash());
+    assert(board.evalScore(PieceColor::WHITE) == board.computeEvalScore(PieceColor::WHITE));
+}
+
+void GameState::unmakeMove() {
+    if (undoStack.empty()) return;
+    
+    const UndoInfo& undo = undoStack.back();
+    const Move& move = undo.move;
+    
+    // Đổi lượt lại
+    currentTurn = oppositeColor(currentTurn);
+    
+    undoMoveInternal(move, undo.capturedPiece);
+    
+    unpackCastlingFlags(undo.castlingFlags);
+    enPassantTarget = undo.enPassantTarget;
+    stateKey = undo.stateKey;
+    halfmoveClock = undo.halfmoveClock;
+    if (currentTurn == PieceColor::BLACK) {
+        fullmoveNumber--;
     }
+    keyHistory.pop_back();
+    assert(hash() == computeHash());
+    assert(board.evalScore(PieceColor::WHITE) == board.computeEvalScore(PieceColor::WHITE));
     
-    /**
-     * Load game state từ FEN string
-     * Format: FEN board + turn + castling + en passant
-     */
-    bool loadFromFEN(const std::string& fen) {
-        std::istringstream iss(fen);
-        std::string boardFEN, turnStr, castlingStr, enPassantStr;
-        
-        iss >> boardFEN >> turnStr >> castlingStr >> enPassantStr;
-        
-        // Load board
-        if (!board.fromFEN(boardFEN)) return false;
-        
-        // Load turn
-        currentTurn = (turnStr == "w") ? PieceColor::WHITE : PieceColor::BLACK;
-        
-        // Load castling rights
-        whiteKingMoved = (castlingStr.find('K') == std::string::npos && castlingStr.find('Q') == std::string::npos);
-        blackKingMoved = (castlingStr.find('k') == std::string::npos && castlingStr.find('q') == std::string::npos);
-        whiteRookKingSideMoved = (castlingStr.find('K') == std::string::npos);
-        whiteRookQueenSideMoved = (castlingStr.find('Q') == std::string::npos);
-        blackRookKingSideMoved = (castlingStr.find('k') == std::string::npos);
-        blackRookQueenSideMoved = (castlingStr.find('q') == std::string::npos);
-        
-        // Load en passant
-        if (enPassantStr != "-") {
-            enPassantTarget = Position::fromNotation(enPassantStr);
-        } else {
-            enPassantTarget = Position();
-        }
-        
-        return true;
+    if (!undo.capturedPiece.isEmpty()) {
+        capturedPieces.pop_back();
     }
+    moveHistory.pop_back();
+    undoStack.pop_back();
+}
+
+void GameState::applyNullMove() {
+    UndoInfo undo;
+    undo.castlingFlags = packCastlingFlags();
+    undo.enPassantTarget = enPassantTarget;
+    undo.stateKey = stateKey;
+    undo.halfmoveClock = halfmoveClock;
+    undoStack.push_back(undo);
+    keyHistory.push_back(hash());
     
-    /**
-     * Export game state ra FEN string
-     */
-    std::string toFEN() const {
-        std::string fen = board.toFEN();
-        
-        // Thêm turn
-        fen += " ";
-        fen += (currentTurn == PieceColor::WHITE) ? "w" : "b";
-        
-        // Thêm castling rights
-        fen += " ";
-        std::string castling;
-        if (!whiteKingMoved) {
-            if (!whiteRookKingSideMoved) castling += "K";
-            if (!whiteRookQueenSideMoved) castling += "Q";
-        }
-        if (!blackKingMoved) {
-            if (!blackRookKingSideMoved) castling += "k";
-            if (!blackRookQueenSideMoved) castling += "q";
-        }
-        if (castling.empty()) castling = "-";
-        fen += castling;
-        
-        // Thêm en passant
-        fen += " ";
-        if (enPassantTarget.isValid()) {
-            fen += enPassantTarget.toNotation();
-        } else {
-            fen += "-";
+    const ZobristKeys& keys = zobristKeys();
+    stateKey ^= enPassantKey(enPassantTarget, currentTurn) ^ keys.side;
+    enPassantTarget = Position();
+    halfmoveClock = 0;
+    currentTurn = oppositeColor(currentTurn);
+    assert(hash() == computeHash());
+}
+
+void GameState::unmakeNullMove() {
+    if (undoStack.empty()) return;
+    
+    const UndoInfo& undo = undoStack.back();
+    currentTurn = oppositeColor(currentTurn);
+    enPassantTarget = undo.enPassantTarget;
+    stateKey = undo.stateKey;
+    halfmoveClock = undo.halfmoveClock;
+    keyHistory.pop_back();
+    undoStack.pop_back();
+}
+
+int GameState::repetitionCount(int maxCount) const {
+    // Vị trí lặp lại phải cùng lượt đi => chỉ xét các ply cách số chẵn
+    ZobristKey key = hash();
+    int count = 0;
+    int limit = std::min(halfmoveClock, static_cast<int>(keyHistory.size()));
+    for (int distance = 4; distance <= limit; distance += 2) {
+        if (keyHistory[keyHistory.size() - distance] == key && ++count >= maxCount) {
+            break;
         }
-        
-        return fen;
     }
-};
+    return count;
+}
+
+bool GameState::isInCheck(PieceColor color) const {
+    Position kingPos = findKing(color);
+    if (!kingPos.isValid()) return false;
+    
+    PieceColor enemyColor = (color == PieceColor::WHITE) ? PieceColor::BLACK : PieceColor::WHITE;
+    return isSquareAttacked(kingPos, enemyColor);
+}
+
+bool GameState::isCheckmate(PieceColor color) const {
+    // Phải đang bị chiếu VÀ không có nước đi hợp lệ
+    if (!isInCheck(color)) return false;
+    
+    // Tạm thời thay đổi turn để getLegalMoves
+    GameState* mutableThis = const_cast<GameState*>(this);
+    PieceColor savedTurn = mutableThis->currentTurn;
+    mutableThis->currentTurn = color;
+    MoveList legalMoves = mutableThis->getLegalMoves();
+    mutableThis->currentTurn = savedTurn;
+    
+    return legalMoves.empty();
+}
+
+bool GameState::isStalemate(PieceColor color) const {
+    // KHÔNG bị chiếu NHƯNG không có nước đi hợp lệ
+    if (isInCheck(color)) return false;
+    
+    // Tạm thời thay đổi turn để getLegalMoves
+    GameState* mutableThis = const_cast<GameState*>(this);
+    PieceColor savedTurn = mutableThis->currentTurn;
+    mutableThis->currentTurn = color;
+    MoveList legalMoves = mutableThis->getLegalMoves();
+    mutableThis->currentTurn = savedTurn;
+    
+    return legalMoves.empty();
+}
+
+int GameState::calculateMaterialValue(PieceColor color) const {
+    static const PieceType types[6] = {
+        PieceType::PAWN, PieceType::KNIGHT, PieceType::BISHOP,
+        PieceType::ROOK, PieceType::QUEEN, PieceType::KING
+    };
+    int total = 0;
+    
+    // Cộng giá trị theo số quân từng loại (Board đếm sẵn, không quét bàn cờ)
+    for (PieceType type : types) {
+        total += Piece(type, color).value * board.pieceCount(type, color);  // Phép cộng (+) - YÊU CẦU
+    }
+    
+    return total;
+}
+
+bool GameState::loadFromFEN(const std::string& fen) {
+    std::istringstream iss(fen);
+    std::string boardFEN, turnStr, castlingStr, enPassantStr;
+    int halfmoves = 0, fullmoves = 1;
+    
+    // Thiếu 2 trường cuối => giữ mặc định; giá trị sai được chỉnh bên dưới
+    iss >> boardFEN >> turnStr >> castlingStr >> enPassantStr >> halfmoves >> fullmoves;
+    
+    // Load board
+    if (!board.fromFEN(boardFEN)) return false;
+    
+    // Vị trí mới - không thể hoàn tác về trước đó
+    undoStack.clear();
+    moveHistory.clear();
+    capturedPieces.clear();
+    keyHistory.clear();
+    halfmoveClock = std::max(halfmoves, 0);
+    fullmoveNumber = std::max(fullmoves, 1);
+    
+    // Load turn
+    currentTurn = (turnStr == "w") ? PieceColor::WHITE : PieceColor::BLACK;
+    
+    // Load castling rights
+    whiteKingMoved = (castlingStr.find('K') == std::string::npos && castlingStr.find('Q') == std::string::npos);
+    blackKingMoved = (castlingStr.find('k') == std::string::npos && castlingStr.find('q') == std::string::npos);
+    whiteRookKingSideMoved = (castlingStr.find('K') == std::string::npos);
+    whiteRookQueenSideMoved = (castlingStr.find('Q') == std::string::npos);
+    blackRookKingSideMoved = (castlingStr.find('k') == std::string::npos);
+    blackRookQueenSideMoved = (castlingStr.find('q') == std::string::npos);
+    
+    // Load en passant
+    if (enPassantStr != "-") {
+        enPassantTarget = Position::fromNotation(enPassantStr);
+    } else {
+        enPassantTarget = Position();
+    }
+    
+    stateKey = computeStateKey();
+    return true;
+}
+
+std::string GameState::toFEN() const {
+    std::string fen = board.toFEN();
+    
+    // Thêm turn
+    fen += " ";
+    fen += (currentTurn == PieceColor::WHITE) ? "w" : "b";
+    
+    // Thêm castling rights
+    fen += " ";
+    std::string castling;
+    if (!whiteKingMoved) {
+        if (!whiteRookKingSideMoved) castling += "K";
+        if (!whiteRookQueenSideMoved) castling += "Q";
+    }
+    if (!blackKingMoved) {
+        if (!blackRookKingSideMoved) castling += "k";
+        if (!blackRookQueenSideMoved) castling += "q";
+    }
+    if (castling.empty()) castling = "-";
+    fen += castling;
+    
+    // Thêm en passant
+    fen += " ";
+    if (enPassantTarget.isValid()) {
+        fen += enPassantTarget.toNotation();
+    } else {
+        fen += "-";
+    }
+    
+    // Thêm halfmove clock và fullmove number
+    fen += " " + std::to_string(halfmoveClock) + " " + std::to_string(fullmoveNumber);
+    
+    return fen;
+}
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "Board.h"
+#include "Move.h"
+#include "MoveGenerator.h"
+#include "MoveList.h"
+
+/**
+ * Bản ghi để hoàn tác một nước đi (make/unmake)
+ * Chỉ lưu phần trạng thái không suy ra được từ nước đi
+ */
+struct UndoInfo {
+    Move move;                 // Nước đi đã thực hiện
+    Piece capturedPiece;       // Quân bị bắt (kể cả en passant), rỗng nếu không bắt
+    std::uint8_t castlingFlags; // 6 cờ castling đóng gói theo bit
+    Position enPassantTarget;  // En passant target trước nước đi
+    ZobristKey stateKey;       // Khóa lượt/castling/en passant trước nước đi
+    int halfmoveClock;         // Halfmove clock trước nước đi
+};
+
+/**
+ * Class quản lý trạng thái game cờ vua
+ * Bao gồm: board, turn, move history, captured pieces, castling rights, en passant
+ */
+class GameState {
+private:
+    Board board;                          // Bàn cờ hiện tại
+    PieceColor currentTurn;               // Lượt đi hiện tại
+    std::vector<Move> moveHistory;        // Lịch sử nước đi (YÊU CẦU)
+    std::vector<Piece> capturedPieces;    // Quân bị bắt (YÊU CẦU)
+    
+    // Castling rights
+    bool whiteKingMoved;
+    bool blackKingMoved;
+    bool whiteRookKingSideMoved;
+    bool whiteRookQueenSideMoved;
+    bool blackRookKingSideMoved;
+    bool blackRookQueenSideMoved;
+    
+    // En passant target
+    Position enPassantTarget;
+    
+    // Move generator
+    MoveGenerator moveGenerator;
+    
+    // Phần Zobrist ngoài quân cờ (lượt, castling, en passant) - phần quân nằm trong Board
+    ZobristKey stateKey;
+    
+    // Undo stack cho make/unmake (search chạy tại chỗ, không copy GameState)
+    std::vector<UndoInfo> undoStack;
+    
+    // Luật 50 nước và số thứ tự nước đi (2 trường cuối của FEN)
+    int halfmoveClock;     // Số ply từ lần bắt quân / đi tốt gần nhất
+    int fullmoveNumber;    // Tăng sau mỗi nước của Black, bắt đầu từ 1
+    
+    // Khóa Zobrist của các vị trí trước mỗi ply đã đi (kể cả null move), để phát hiện lặp lại
+    std::vector<ZobristKey> keyHistory;
+    
+    /**
+     * Đóng gói 6 cờ castling vào 1 byte (để lưu vào UndoInfo)
+     */
+    std::uint8_t packCastlingFlags() const {
+        return static_cast<std::uint8_t>(
+            (whiteKingMoved ? 1 : 0) | (blackKingMoved ? 2 : 0) |
+            (whiteRookKingSideMoved ? 4 : 0) | (whiteRookQueenSideMoved ? 8 : 0) |
+            (blackRookKingSideMoved ? 16 : 0) | (blackRookQueenSideMoved ? 32 : 0));
+    }
+    
+    void unpackCastlingFlags(std::uint8_t flags) {
+        whiteKingMoved = (flags & 1) != 0;
+        blackKingMoved = (flags & 2) != 0;
+        whiteRookKingSideMoved = (flags & 4) != 0;
+        whiteRookQueenSideMoved = (flags & 8) != 0;
+        blackRookKingSideMoved = (flags & 16) != 0;
+        blackRookQueenSideMoved = (flags & 32) != 0;
+    }
+    
+    /**
+     * Quyền castling hiệu lực dạng 4 bit (K, Q, k, q) - chỉ số vào ZobristKeys::castling
+     */
+    int castlingRights() const {
+        return (!whiteKingMoved && !whiteRookKingSideMoved ? 1 : 0) |
+               (!whiteKingMoved && !whiteRookQueenSideMoved ? 2 : 0) |
+               (!blackKingMoved && !blackRookKingSideMoved ? 4 : 0) |
+               (!blackKingMoved && !blackRookQueenSideMoved ? 8 : 0);
+    }
+    
+    /**
+     * Khóa en passant: chỉ tính khi có tốt của bên capturer thực sự bắt được
+     * (để 2 vị trí giống hệt nhau không bị khác hash chỉ vì một nước đi 2 ô)
+     */
+    ZobristKey enPassantKey(const Position& target, PieceColor capturer) const;
+    
+    /**
+     * Tính lại stateKey từ đầu (lượt + castling + en passant)
+     */
+    ZobristKey computeStateKey() const;
+    
+    /**
+     * Tìm vị trí vua của một bên
+     */
+    Position findKing(PieceColor color) const;
+    
+    /**
+     * Kiểm tra một ô có bị tấn công bởi bên địch không
+     * Tra bảng tấn công ngược từ ô cần kiểm tra rồi giao với bitboard quân địch
+     */
+    bool isSquareAttacked(const Position& pos, PieceColor byColor) const;
+    
+    /**
+     * Apply move lên board (không kiểm tra tính hợp lệ)
+     */
+    void applyMoveInternal(const Move& move);
+
+    /**
+     * Hoàn tác applyMoveInternal trên board (chỉ board, không đụng các cờ khác)
+     * @param capturedPiece: quân bị bắt bởi move (rỗng nếu không bắt)
+     */
+    void undoMoveInternal(const Move& move, const Piece& capturedPiece);
+
+    /**
+     * Copy toàn bộ trạng thái (trừ moveGenerator) từ state khác
+     */
+    void copyFrom(const GameState& other);
+
+public:
+    /**
+     * Constructor
+     */
+    GameState() : moveGenerator(board) {
+        undoStack.reserve(256);
+        keyHistory.reserve(256);
+        moveHistory.reserve(256);
+        capturedPieces.reserve(32);
+        reset();
+    }
+    
+    /**
+     * Copy constructor / assignment
+     * MoveGenerator giữ tham chiếu tới board nên phải gắn lại vào board của bản copy
+     */
+    GameState(const GameState& other) : moveGenerator(board) {
+        copyFrom(other);
+    }
+    
+    GameState& operator=(const GameState& other) {
+        if (this != &other) {
+            copyFrom(other);
+        }
+        return *this;
+    }
+    
+    /**
+     * Reset game về trạng thái khởi đầu
+     */
+    void reset();
+    
+    /**
+     * Lấy board hiện tại (const)
+     */
+    const Board& getBoard() const { return board; }
+    
+    /**
+     * Lấy lượt đi hiện tại
+     */
+    PieceColor getCurrentTurn() const { return currentTurn; }
+    
+    /**
+     * Lấy lịch sử nước đi
+     */
+    const std::vector<Move>& getMoveHistory() const { return moveHistory; }
+    
+    /**
+     * Lấy danh sách quân bị bắt
+     */
+    const std::vector<Piece>& getCapturedPieces() const { return capturedPieces; }
+    
+    /**
+     * Quyền castling hiện tại dạng 4 bit (K, Q, k, q)
+     */
+    int getCastlingRights() const { return castlingRights(); }
+    
+    /**
+     * Lấy en passant target
+     */
+    Position getEnPassantTarget() const { return enPassantTarget; }
+    
+    /**
+     * Khóa Zobrist 64-bit của vị trí hiện tại (cập nhật tăng dần, O(1))
+     */
+    ZobristKey hash() const { return board.hash() ^ stateKey; }
+    
+    /**
+     * Tính lại khóa Zobrist từ đầu (chậm - để kiểm tra hash())
+     */
+    ZobristKey computeHash() const { return board.computeHash() ^ computeStateKey(); }
+    
+    /**
+     * Sinh tất cả legal moves cho bên đang đi
+     */
+    MoveList getLegalMoves();
+    
+    /**
+     * Chỉ các nước bắt quân và phong cấp hợp lệ (cho quiescence search)
+     */
+    MoveList getLegalCaptures();
+    
+    /**
+     * Thực hiện nước đi do người chơi/file save đưa vào (có kiểm tra hợp lệ)
+     * Nước đi được đối chiếu với danh sách legal moves theo from/to;
+     * loại nước đi và quân bị bắt lấy từ legal move tìm được
+     * @param move: nước đi cần thực hiện (có thể tạo từ Move::fromNotation)
+     * @return true nếu thành công, false nếu không hợp lệ
+     */
+    bool makeMove(const Move& move);
+    
+    /**
+     * Thực hiện nước đi đã biết là hợp lệ (KHÔNG kiểm tra)
+     * Dùng cho engine khi move lấy từ chính getLegalMoves() của vị trí này
+     * Có thể hoàn tác bằng unmakeMove()
+     */
+    void applyMove(const Move& move);
+    
+    /**
+     * Hoàn tác nước đi cuối cùng của makeMove/applyMove (dùng trong search)
+     * Khôi phục board, castling rights, en passant, history và lượt đi
+     */
+    void unmakeMove();
+    
+    /**
+     * Halfmove clock (luật 50 nước: hòa khi >= 100)
+     */
+    int getHalfmoveClock() const { return halfmoveClock; }
+    
+    /**
+     * Số thứ tự nước đi hiện tại (trường cuối của FEN)
+     */
+    int getFullmoveNumber() const { return fullmoveNumber; }
+    
+    /**
+     * Số lần vị trí hiện tại đã xuất hiện trước đó (cùng lượt đi, castling, en passant)
+     * Chỉ duyệt lùi tới nước không hoàn tác được gần nhất (bắt quân, đi tốt, null move)
+     * @param maxCount: dừng sớm khi đã đếm đủ (2 = lặp lại 3 lần)
+     */
+    int repetitionCount(int maxCount = 2) const;
+    
+    /**
+     * Null move cho search: chỉ đổi lượt (xóa en passant), board giữ nguyên
+     * Không được gọi khi đang bị chiếu; hoàn tác bằng unmakeNullMove()
+     * Halfmove clock về 0 để phát hiện lặp lại không tính qua null move
+     */
+    void applyNullMove();
+    
+    /**
+     * Hoàn tác applyNullMove() gần nhất
+     */
+    void unmakeNullMove();
+    
+    /**
+     * Kiểm tra vua có bị chiếu không
+     * @param color: màu của bên cần kiểm tra
+     * @return true nếu bị chiếu
+     */
+    bool isInCheck(PieceColor color) const;
+    
+    /**
+     * Kiểm tra checkmate
+     * @param color: màu của bên cần kiểm tra
+     * @return true nếu bị chiếu hết
+     */
+    bool isCheckmate(PieceColor color) const;
+    
+    /**
+     * Kiểm tra stalemate (hòa cờ)
+     * @param color: màu của bên cần kiểm tra
+     * @return true nếu hòa
+     */
+    bool isStalemate(PieceColor color) const;
+    
+    /**
+     * Tính tổng giá trị material của một bên
+     * (YÊU CẦU: phép tính +, ảnh hưởng đầu ra)
+     * @param color: màu của bên cần tính
+     * @return tổng điểm
+     */
+    int calculateMaterialValue(PieceColor color) const;
+    
+    /**
+     * Đánh giá tĩnh material + piece-square tables (tapered), tính theo góc nhìn color
+     * O(1): Board cộng dồn theo từng thay đổi quân trong make/unmake
+     * @return centipawn, dương nếu color đang hơn
+     */
+    int staticEvaluation(PieceColor color) const {
+        return board.evalScore(color) - board.evalScore(oppositeColor(color));
+    }
+    
+    /**
+     * Load game state từ FEN string
+     * Format: FEN board + turn + castling + en passant [+ halfmove clock + fullmove number]
+     * Thiếu 2 trường cuối thì dùng 0 và 1
+     */
+    bool loadFromFEN(const std::string& fen);
+    
+    /**
+     * Export game state ra FEN string
+     */
+    std::string toFEN() const;
+};
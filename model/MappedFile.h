@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * File chỉ đọc được map vào bộ nhớ (mmap / MapViewOfFile)
+ * Hệ điều hành chỉ nạp trang nào thực sự được đọc => mở file lớn gần như tức thì
+ */
+class MappedFile {
+private:
+    const std::uint8_t* mapped;
+    std::size_t length;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Map toàn bộ file (đóng file cũ nếu có)
+     * @return false nếu không mở được hoặc file rỗng
+     */
+    bool open(const std::string& path);
+
+    /**
+     * Bỏ map và đóng file
+     */
+    void close();
+
+    bool isOpen() const { return mapped != nullptr; }
+    const std::uint8_t* data() const { return mapped; }
+    std::size_t size() const { return length; }
+};
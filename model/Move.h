@@ -0,0 +1,123 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+#include "Piece.h"
+#include "Position.h"
+
+/**
+ * Enum định nghĩa các loại nước đi đặc biệt
+ */
+enum class MoveType {
+    NORMAL,            // Nước đi thông thường
+    CASTLE_KINGSIDE,   // Nhập thành cánh vua
+    CASTLE_QUEENSIDE,  // Nhập thành cánh hậu
+    EN_PASSANT,        // Bắt tốt qua đường
+    PROMOTION          // Phong cấp tốt
+};
+
+/**
+ * Nước đi đóng gói trong 32 bit (4 byte thay vì ~36 byte của 2 Position + Piece)
+ *   bit 0-5:   ô xuất phát (index 0-63, giống Board)
+ *   bit 6-11:  ô đích
+ *   bit 12-14: quân phong cấp (PieceType)
+ *   bit 16-18: MoveType
+ *   bit 19-23: quân bị bắt (encodePiece), 0 = không bắt
+ * 16 bit thấp đủ định danh nước đi trong một vị trí => dùng cho TT và killer
+ * Move() = 0 = nước rỗng (ô xuất phát trùng ô đích không bao giờ là nước hợp lệ)
+ */
+struct Move {
+    // Constructor mặc định - nước rỗng
+    Move() : data(0) {}
+    
+    /**
+     * Constructor tạo nước đi thông thường
+     * @param f: vị trí xuất phát
+     * @param t: vị trí đích
+     */
+    Move(Position f, Position t) : Move(f, t, MoveType::NORMAL) {}
+    
+    /**
+     * Constructor tạo nước đi với loại cụ thể
+     * @param f: vị trí xuất phát
+     * @param t: vị trí đích
+     * @param type: loại nước đi
+     */
+    Move(Position f, Position t, MoveType type) : data(0) {
+        if (f.isValid() && t.isValid()) {
+            data = pack(f.row * 8 + f.col, t.row * 8 + t.col, type);
+        }
+    }
+    
+    /**
+     * Constructor theo index ô (dùng trong engine)
+     */
+    Move(int fromSquare, int toSquare, MoveType type = MoveType::NORMAL)
+        : data(pack(fromSquare, toSquare, type)) {}
+    
+    bool isNull() const { return data == 0; }
+    
+    int fromSquare() const { return data & 63; }
+    int toSquare() const { return (data >> 6) & 63; }
+    
+    /**
+     * Vị trí xuất phát/đích (Position không hợp lệ nếu là nước rỗng)
+     */
+    Position from() const { return isNull() ? Position() : Position(fromSquare() >> 3, fromSquare() & 7); }
+    Position to() const { return isNull() ? Position() : Position(toSquare() >> 3, toSquare() & 7); }
+    
+    MoveType moveType() const { return static_cast<MoveType>((data >> 16) & 7); }
+    PieceType promotionPiece() const { return static_cast<PieceType>((data >> 12) & 7); }
+    Piece capturedPiece() const { return decodePiece(capturedCode()); }
+    std::uint8_t capturedCode() const { return static_cast<std::uint8_t>((data >> 19) & 31); }
+    bool isCapture() const { return capturedCode() != 0; }
+    
+    void setMoveType(MoveType type) {
+        data = (data & ~(7u << 16)) | (static_cast<std::uint32_t>(type) << 16);
+    }
+    void setPromotionPiece(PieceType type) {
+        data = (data & ~(7u << 12)) | (static_cast<std::uint32_t>(type) << 12);
+    }
+    void setCapturedPiece(const Piece& piece) {
+        data = (data & ~(31u << 19)) | (static_cast<std::uint32_t>(encodePiece(piece)) << 19);
+    }
+    
+    /**
+     * 16 bit định danh (from, to, quân phong cấp) - lưu trong TT/killer
+     */
+    std::uint16_t move16() const { return static_cast<std::uint16_t>(data & 0xFFFF); }
+    
+    /**
+     * Chuyển nước đi sang notation dạng "e2e4" hoặc "e7e8q" (cho promotion)
+     * @return string notation
+     */
+    std::string toNotation() const;
+    
+    /**
+     * Tạo Move từ notation (ví dụ: "e2e4", "e7e8q")
+     * @param notation: string notation
+     * @return Move object
+     */
+    static Move fromNotation(const std::string& notation);
+    
+    // So sánh hai nước đi (không so quân bị bắt)
+    bool operator==(const Move& other) const {
+        return (data & IDENTITY_MASK) == (other.data & IDENTITY_MASK);
+    }
+    
+    bool operator!=(const Move& other) const {
+        return !(*this == other);
+    }
+
+private:
+    static const std::uint32_t IDENTITY_MASK = 0x7FFFF;  // from, to, phong cấp, MoveType
+    
+    std::uint32_t data;
+    
+    static std::uint32_t pack(int fromSquare, int toSquare, MoveType type) {
+        return static_cast<std::uint32_t>(fromSquare) |
+               (static_cast<std::uint32_t>(toSquare) << 6) |
+               (static_cast<std::uint32_t>(type) << 16);
+    }
+};
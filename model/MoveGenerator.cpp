@@ -1,282 +1,293 @@
-#include <vector>
+#include "MoveGenerator.h"
 
-/**
- * Class sinh ra tất cả các nước đi hợp lệ (pseudo-legal moves)
- * Không kiểm tra check - chỉ sinh moves theo luật di chuyển cơ bản
- */
-class MoveGenerator {
-private:
-    Board& board;
-    std::vector<Move> moves;  // Danh sách moves được sinh ra
+Bitboard MoveGenerator::attackersTo(int square, Bitboard occupied) const {
+    Bitboard rooksQueens = board.pieces(PieceType::ROOK) | board.pieces(PieceType::QUEEN);
+    Bitboard bishopsQueens = board.pieces(PieceType::BISHOP) | board.pieces(PieceType::QUEEN);
     
-    /**
-     * Thêm move nếu ô đích hợp lệ
-     * @return true nếu ô trống (có thể tiếp tục), false nếu bị chặn
-     */
-    bool addMoveIfValid(const Position& from, const Position& to, PieceColor color) {
-        if (!to.isValid()) return false;
-        
-        Piece targetPiece = board.getPiece(to);
-        
-        // Nếu ô trống, thêm move
-        if (targetPiece.isEmpty()) {
-            moves.push_back(Move(from, to));
-            return true; // Có thể tiếp tục
-        }
-        
-        // Nếu là quân địch, có thể bắt
-        if (targetPiece.color != color) {
-            Move move(from, to);
-            move.capturedPiece = targetPiece;
-            moves.push_back(move);
-        }
-        
-        return false; // Bị chặn, không thể tiếp tục
+    return (pawnAttacks(PieceColor::WHITE, square) & board.pieces(PieceType::PAWN, PieceColor::BLACK)) |
+           (pawnAttacks(PieceColor::BLACK, square) & board.pieces(PieceType::PAWN, PieceColor::WHITE)) |
+           (knightAttacks(square) & board.pieces(PieceType::KNIGHT)) |
+           (kingAttacks(square) & board.pieces(PieceType::KING)) |
+           (rookAttacks(square, occupied) & rooksQueens) |
+           (bishopAttacks(square, occupied) & bishopsQueens);
+}
+
+void MoveGenerator::computeCheckInfo(PieceColor color) {
+    checkers = 0;
+    checkMask = ~0ULL;
+    pinned = 0;
+    kingSquare = board.kingSquare(color);
+    
+    if (kingSquare < 0) return;  // Vị trí không có vua: không ràng buộc gì
+    
+    Bitboard enemy = board.pieces(oppositeColor(color));
+    Bitboard occupied = board.occupied();
+    
+    checkers = attackersTo(kingSquare, occupied) & enemy;
+    if (checkers && !(checkers & (checkers - 1))) {
+        // Chiếu đơn: chặn đường chiếu hoặc bắt quân chiếu
+        checkMask = betweenBB(kingSquare, lsbIndex(checkers)) | checkers;
     }
     
-    /**
-     * Sinh moves theo một hướng cụ thể (cho Rook, Bishop, Queen)
-     */
-    void generateSlidingMoves(const Position& from, int dirRow, int dirCol, PieceColor color) {
-        Position current = from;
+    // Quân địch trượt nhìn thẳng về vua trên bàn trống (sniper)
+    Bitboard queens = board.pieces(PieceType::QUEEN);
+    Bitboard snipers = enemy & (
+        (rookAttacks(kingSquare, 0) & (board.pieces(PieceType::ROOK) | queens)) |
+        (bishopAttacks(kingSquare, 0) & (board.pieces(PieceType::BISHOP) | queens)));
+    
+    while (snipers) {
+        int sniper = popLsb(snipers);
+        Bitboard blockers = betweenBB(kingSquare, sniper) & occupied;
         
-        while (true) {
-            current.row += dirRow;
-            current.col += dirCol;
-            
-            if (!addMoveIfValid(from, current, color)) {
-                break; // Gặp quân cản hoặc ra ngoài bàn cờ
-            }
+        // Đúng một quân cản và là quân mình => bị ghim
+        if (blockers && !(blockers & (blockers - 1)) && (blockers & board.pieces(color))) {
+            pinned |= blockers;
         }
     }
+}
+
+Bitboard MoveGenerator::allowedTargets(int square) const {
+    if (pinned & squareBB(square)) {
+        return checkMask & lineBB(kingSquare, square);
+    }
+    return checkMask;
+}
+
+void MoveGenerator::addMoves(int from, Bitboard targets) {
+    while (targets) {
+        int to = popLsb(targets);
+        Move move(from, to);
+        move.setCapturedPiece(board.pieceAt(to));  // Rỗng nếu ô trống
+        moves->push_back(move);
+    }
+}
+
+void MoveGenerator::addPromotions(const Move& base) {
+    static const PieceType promotionTypes[4] = {
+        PieceType::QUEEN, PieceType::ROOK, PieceType::BISHOP, PieceType::KNIGHT
+    };
+    
+    for (PieceType type : promotionTypes) {
+        Move move = base;
+        move.setMoveType(MoveType::PROMOTION);
+        move.setPromotionPiece(type);
+        moves->push_back(move);
+    }
+}
+
+void MoveGenerator::generatePawnMoves(int square, PieceColor color, const Position& enPassantTarget) {
+    int direction = (color == PieceColor::WHITE) ? -8 : 8;  // White đi lên, Black đi xuống
+    int row = square >> 3;
+    int startRow = (color == PieceColor::WHITE) ? 6 : 1;     // Hàng khởi đầu
+    int promotionRow = (color == PieceColor::WHITE) ? 0 : 7; // Hàng phong cấp
+    Bitboard empty = ~board.occupied();
+    Bitboard allowed = allowedTargets(square);
     
-    /**
-     * Sinh nước đi cho Pawn (Tốt)
-     */
-    void generatePawnMoves(const Position& pos, PieceColor color, const Position& enPassantTarget) {
-        int direction = (color == PieceColor::WHITE) ? -1 : 1;  // White đi lên, Black đi xuống
-        int startRow = (color == PieceColor::WHITE) ? 6 : 1;     // Hàng khởi đầu
-        int promotionRow = (color == PieceColor::WHITE) ? 0 : 7; // Hàng phong cấp
+    // Di chuyển 1 ô về phía trước (chế độ capturesOnly: chỉ khi phong cấp)
+    int forward = square + direction;
+    bool promotes = (forward >> 3) == promotionRow;
+    if (forward >= 0 && forward < 64 && (empty & squareBB(forward)) && (promotes || !capturesOnly)) {
+        Move move(square, forward);
         
-        // Di chuyển 1 ô về phía trước
-        Position forward(pos.row + direction, pos.col);
-        if (forward.isValid() && board.getPiece(forward).isEmpty()) {
-            Move move(pos, forward);
-            
+        // Ô đích phải chặn được chiếu / nằm trên đường ghim
+        if (allowed & squareBB(forward)) {
             // Kiểm tra promotion
-            if (forward.row == promotionRow) {
-                move.moveType = MoveType::PROMOTION;
-                move.promotionPiece = PieceType::QUEEN; // Default
-            }
-            
-            moves.push_back(move);
-            
-            // Di chuyển 2 ô nếu ở vị trí khởi đầu
-            if (pos.row == startRow) {
-                Position forward2(pos.row + 2 * direction, pos.col);
-                if (board.getPiece(forward2).isEmpty()) {
-                    moves.push_back(Move(pos, forward2));
-                }
+            if (promotes) {
+                addPromotions(move);
+            } else {
+                moves->push_back(move);
             }
         }
         
-        // Bắt quân chéo (capture)
-        for (int dcol : {-1, 1}) {
-            Position diagonal(pos.row + direction, pos.col + dcol);
-            if (diagonal.isValid()) {
-                Piece targetPiece = board.getPiece(diagonal);
-                
-                // Bắt quân địch
-                if (!targetPiece.isEmpty() && targetPiece.color != color) {
-                    Move move(pos, diagonal);
-                    move.capturedPiece = targetPiece;
-                    
-                    // Promotion
-                    if (diagonal.row == promotionRow) {
-                        move.moveType = MoveType::PROMOTION;
-                        move.promotionPiece = PieceType::QUEEN;
-                    }
-                    
-                    moves.push_back(move);
-                }
-                
-                // En passant
-                if (diagonal == enPassantTarget && enPassantTarget.isValid()) {
-                    Move move(pos, diagonal, MoveType::EN_PASSANT);
-                    move.capturedPiece = Piece(PieceType::PAWN, 
-                        (color == PieceColor::WHITE) ? PieceColor::BLACK : PieceColor::WHITE);
-                    moves.push_back(move);
-                }
-            }
+        // Di chuyển 2 ô nếu ở vị trí khởi đầu
+        int forward2 = forward + direction;
+        if (row == startRow && !capturesOnly && (empty & allowed & squareBB(forward2))) {
+            moves->push_back(Move(square, forward2));
         }
     }
     
-    /**
-     * Sinh nước đi cho Knight (Mã) - hình chữ L
-     */
-    void generateKnightMoves(const Position& pos, PieceColor color) {
-        // 8 vị trí có thể đi của mã
-        int knightMoves[8][2] = {
-            {-2, -1}, {-2, 1}, {-1, -2}, {-1, 2},
-            {1, -2}, {1, 2}, {2, -1}, {2, 1}
-        };
+    // Bắt quân chéo (capture)
+    Bitboard attacks = pawnAttacks(color, square);
+    Bitboard captures = attacks & allowed & board.pieces(oppositeColor(color));
+    
+    while (captures) {
+        int to = popLsb(captures);
+        Move move(square, to);
+        move.setCapturedPiece(board.pieceAt(to));
         
-        for (int i = 0; i < 8; i++) {
-            Position to(pos.row + knightMoves[i][0], pos.col + knightMoves[i][1]);
-            addMoveIfValid(pos, to, color);
+        // Promotion
+        if ((to >> 3) == promotionRow) {
+            addPromotions(move);
+        } else {
+            moves->push_back(move);
         }
     }
     
-    /**
-     * Sinh nước đi cho Bishop (Tượng) - đi chéo
-     */
-    void generateBishopMoves(const Position& pos, PieceColor color) {
-        // 4 hướng chéo
-        generateSlidingMoves(pos, -1, -1, color);  // Trái trên
-        generateSlidingMoves(pos, -1, 1, color);   // Phải trên
-        generateSlidingMoves(pos, 1, -1, color);   // Trái dưới
-        generateSlidingMoves(pos, 1, 1, color);    // Phải dưới
+    // En passant
+    if (enPassantTarget.isValid() && (attacks & squareBB(squareIndex(enPassantTarget))) &&
+        isEnPassantLegal(square, squareIndex(enPassantTarget), color)) {
+        Move move(square, squareIndex(enPassantTarget), MoveType::EN_PASSANT);
+        move.setCapturedPiece(Piece(PieceType::PAWN, oppositeColor(color)));
+        moves->push_back(move);
     }
+}
+
+bool MoveGenerator::isEnPassantLegal(int from, int to, PieceColor color) const {
+    if (kingSquare < 0) return true;
     
-    /**
-     * Sinh nước đi cho Rook (Xe) - đi ngang/dọc
-     */
-    void generateRookMoves(const Position& pos, PieceColor color) {
-        // 4 hướng ngang/dọc
-        generateSlidingMoves(pos, -1, 0, color);   // Lên
-        generateSlidingMoves(pos, 1, 0, color);    // Xuống
-        generateSlidingMoves(pos, 0, -1, color);   // Trái
-        generateSlidingMoves(pos, 0, 1, color);    // Phải
-    }
+    // Tốt bị bắt nằm cùng hàng với ô xuất phát, cùng cột với ô đích
+    int capturedSquare = (from & ~7) | (to & 7);
+    Bitboard occupied = (board.occupied() ^ squareBB(from) ^ squareBB(capturedSquare)) | squareBB(to);
+    Bitboard enemy = board.pieces(oppositeColor(color)) & ~squareBB(capturedSquare);
     
-    /**
-     * Sinh nước đi cho Queen (Hậu) - kết hợp Rook + Bishop
-     */
-    void generateQueenMoves(const Position& pos, PieceColor color) {
-        generateRookMoves(pos, color);
-        generateBishopMoves(pos, color);
-    }
+    // Xét lại toàn bộ sau khi bắt: gỡ chiếu bằng en passant, ghim ngang hai tốt...
+    return !(attackersTo(kingSquare, occupied) & enemy);
+}
+
+void MoveGenerator::generateKnightMoves(int square) {
+    addMoves(square, knightAttacks(square) & targetMask & allowedTargets(square));
+}
+
+void MoveGenerator::generateBishopMoves(int square) {
+    addMoves(square, bishopAttacks(square, board.occupied()) & targetMask & allowedTargets(square));
+}
+
+void MoveGenerator::generateRookMoves(int square) {
+    addMoves(square, rookAttacks(square, board.occupied()) & targetMask & allowedTargets(square));
+}
+
+void MoveGenerator::generateQueenMoves(int square) {
+    addMoves(square, queenAttacks(square, board.occupied()) & targetMask & allowedTargets(square));
+}
+
+void MoveGenerator::generateKingMoves(int square, PieceColor color) {
+    Bitboard targets = kingAttacks(square) & targetMask;
+    Bitboard enemy = board.pieces(oppositeColor(color));
     
-    /**
-     * Sinh nước đi cho King (Vua) - 8 ô xung quanh
-     */
-    void generateKingMoves(const Position& pos, PieceColor color) {
-        // 8 ô xung quanh
-        for (int drow = -1; drow <= 1; drow++) {
-            for (int dcol = -1; dcol <= 1; dcol++) {
-                if (drow == 0 && dcol == 0) continue;
-                Position to(pos.row + drow, pos.col + dcol);
-                addMoveIfValid(pos, to, color);
-            }
-        }
+    // Bỏ vua khỏi occupied để quân trượt "xuyên" qua vị trí cũ của vua
+    Bitboard occupied = board.occupied() ^ squareBB(square);
+    Bitboard safe = 0;
+    
+    while (targets) {
+        int to = popLsb(targets);
+        if (!(attackersTo(to, occupied) & enemy)) safe |= squareBB(to);
     }
     
-    /**
-     * Sinh castling moves (nhập thành)
-     */
-    void generateCastlingMoves(
-        PieceColor color,
-        bool kingMoved,
-        bool rookKingSideMoved,
-        bool rookQueenSideMoved
-    ) {
-        if (kingMoved) return; // Vua đã di chuyển
-        
-        int row = (color == PieceColor::WHITE) ? 7 : 0;
-        Position kingPos(row, 4);
-        
-        // Castling kingside (O-O)
-        if (!rookKingSideMoved) {
-            Position rookPos(row, 7);
-            Piece rook = board.getPiece(rookPos);
+    addMoves(square, safe);
+}
+
+void MoveGenerator::generateCastlingMoves(
+    PieceColor color,
+    bool kingMoved,
+    bool rookKingSideMoved,
+    bool rookQueenSideMoved
+) {
+    if (kingMoved) return; // Vua đã di chuyển
+    if (checkers) return;  // Không nhập thành khi đang bị chiếu
+    
+    int row = (color == PieceColor::WHITE) ? 7 : 0;
+    int kingSquare = row * 8 + 4;
+    
+    Bitboard occupied = board.occupied();
+    Bitboard rooks = board.pieces(PieceType::ROOK, color);
+    Bitboard enemy = board.pieces(oppositeColor(color));
+    
+    // Castling kingside (O-O)
+    if (!rookKingSideMoved) {
+        // Kiểm tra đường giữa vua và xe có trống không, vua không đi qua/đến ô bị tấn công
+        if (!(occupied & (squareBB(row * 8 + 5) | squareBB(row * 8 + 6))) &&
+            (rooks & squareBB(row * 8 + 7)) &&
+            !(attackersTo(row * 8 + 5, occupied) & enemy) &&
+            !(attackersTo(row * 8 + 6, occupied) & enemy)) {
             
-            // Kiểm tra đường giữa vua và xe có trống không
-            if (board.getPiece(Position(row, 5)).isEmpty() &&
-                board.getPiece(Position(row, 6)).isEmpty() &&
-                rook.type == PieceType::ROOK && rook.color == color) {
-                
-                Move move(kingPos, Position(row, 6), MoveType::CASTLE_KINGSIDE);
-                moves.push_back(move);
-            }
+            Move move(kingSquare, row * 8 + 6, MoveType::CASTLE_KINGSIDE);
+            moves->push_back(move);
         }
-        
-        // Castling queenside (O-O-O)
-        if (!rookQueenSideMoved) {
-            Position rookPos(row, 0);
-            Piece rook = board.getPiece(rookPos);
+    }
+    
+    // Castling queenside (O-O-O)
+    if (!rookQueenSideMoved) {
+        // Kiểm tra đường giữa
+        if (!(occupied & (squareBB(row * 8 + 1) | squareBB(row * 8 + 2) | squareBB(row * 8 + 3))) &&
+            (rooks & squareBB(row * 8)) &&
+            !(attackersTo(row * 8 + 3, occupied) & enemy) &&
+            !(attackersTo(row * 8 + 2, occupied) & enemy)) {
             
-            // Kiểm tra đường giữa
-            if (board.getPiece(Position(row, 1)).isEmpty() &&
-                board.getPiece(Position(row, 2)).isEmpty() &&
-                board.getPiece(Position(row, 3)).isEmpty() &&
-                rook.type == PieceType::ROOK && rook.color == color) {
-                
-                Move move(kingPos, Position(row, 2), MoveType::CASTLE_QUEENSIDE);
-                moves.push_back(move);
-            }
+            Move move(kingSquare, row * 8 + 2, MoveType::CASTLE_QUEENSIDE);
+            moves->push_back(move);
         }
     }
+}
 
-public:
-    /**
-     * Constructor
-     */
-    MoveGenerator(Board& b) : board(b) {}
+void MoveGenerator::generatePieceMoves(PieceColor color, const Position& enPassantTarget) {
+    // Chiếu đôi: chỉ vua được đi
+    if (checkers & (checkers - 1)) {
+        generateKingMoves(kingSquare, color);
+        return;
+    }
     
-    /**
-     * Hàm chính: sinh tất cả pseudo-legal moves cho một bên
-     */
-    std::vector<Move> generateMoves(
-        PieceColor color,
-        const Position& enPassantTarget,
-        bool whiteKingMoved, bool blackKingMoved,
-        bool whiteRookKingSideMoved, bool whiteRookQueenSideMoved,
-        bool blackRookKingSideMoved, bool blackRookQueenSideMoved
-    ) {
-        moves.clear();
+    // Chỉ duyệt qua các quân của bên đang đi (bitboard)
+    Bitboard own = board.pieces(color);
+    
+    while (own) {
+        int square = popLsb(own);
         
-        // Duyệt qua toàn bộ bàn cờ (vòng lặp FOR - YÊU CẦU)
-        for (int row = 0; row < 8; row++) {
-            for (int col = 0; col < 8; col++) {
-                Position pos(row, col);
-                Piece piece = board.getPiece(pos);
-                
-                // Chỉ xét quân của bên đang đi
-                if (piece.isEmpty() || piece.color != color) continue;
-                
-                // Sinh moves theo loại quân (SWITCH - YÊU CẦU)
-                switch (piece.type) {
-                    case PieceType::PAWN:
-                        generatePawnMoves(pos, color, enPassantTarget);
-                        break;
-                    case PieceType::KNIGHT:
-                        generateKnightMoves(pos, color);
-                        break;
-                    case PieceType::BISHOP:
-                        generateBishopMoves(pos, color);
-                        break;
-                    case PieceType::ROOK:
-                        generateRookMoves(pos, color);
-                        break;
-                    case PieceType::QUEEN:
-                        generateQueenMoves(pos, color);
-                        break;
-                    case PieceType::KING:
-                        generateKingMoves(pos, color);
-                        break;
-                    default:
-                        break;
-                }
-            }
+        // Sinh moves theo loại quân (SWITCH - YÊU CẦU)
+        switch (board.typeAt(square)) {
+            case PieceType::PAWN:
+                generatePawnMoves(square, color, enPassantTarget);
+                break;
+            case PieceType::KNIGHT:
+                generateKnightMoves(square);
+                break;
+            case PieceType::BISHOP:
+                generateBishopMoves(square);
+                break;
+            case PieceType::ROOK:
+                generateRookMoves(square);
+                break;
+            case PieceType::QUEEN:
+                generateQueenMoves(square);
+                break;
+            case PieceType::KING:
+                generateKingMoves(square, color);
+                break;
+            default:
+                break;
         }
-        
-        // Thêm castling moves
-        bool kingMoved = (color == PieceColor::WHITE) ? whiteKingMoved : blackKingMoved;
-        bool rookKSMoved = (color == PieceColor::WHITE) ? whiteRookKingSideMoved : blackRookKingSideMoved;
-        bool rookQSMoved = (color == PieceColor::WHITE) ? whiteRookQueenSideMoved : blackRookQueenSideMoved;
-        
-        generateCastlingMoves(color, kingMoved, rookKSMoved, rookQSMoved);
-        
-        return moves;
     }
-};
+}
+
+void MoveGenerator::generateMoves(
+    MoveList& list,
+    PieceColor color,
+    const Position& enPassantTarget,
+    bool whiteKingMoved, bool blackKingMoved,
+    bool whiteRookKingSideMoved, bool whiteRookQueenSideMoved,
+    bool blackRookKingSideMoved, bool blackRookQueenSideMoved
+) {
+    list.clear();
+    moves = &list;
+    
+    capturesOnly = false;
+    targetMask = ~board.pieces(color);
+    computeCheckInfo(color);
+    generatePieceMoves(color, enPassantTarget);
+    
+    // Thêm castling moves
+    bool kingMoved = (color == PieceColor::WHITE) ? whiteKingMoved : blackKingMoved;
+    bool rookKSMoved = (color == PieceColor::WHITE) ? whiteRookKingSideMoved : blackRookKingSideMoved;
+    bool rookQSMoved = (color == PieceColor::WHITE) ? whiteRookQueenSideMoved : blackRookQueenSideMoved;
+    
+    generateCastlingMoves(color, kingMoved, rookKSMoved, rookQSMoved);
+}
+
+void MoveGenerator::generateCaptures(MoveList& list, PieceColor color, const Position& enPassantTarget) {
+    list.clear();
+    moves = &list;
+    
+    capturesOnly = true;
+    targetMask = board.pieces(oppositeColor(color));
+    computeCheckInfo(color);
+    generatePieceMoves(color, enPassantTarget);
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Board.h"
+#include "Move.h"
+#include "MoveList.h"
+
+/**
+ * Class sinh ra tất cả các nước đi hợp lệ (legal moves)
+ * Tính trước quân chiếu, check mask và quân bị ghim nên không cần make/unmake để lọc
+ * Truy vấn trực tiếp bitboard của Board, chỉ duyệt các quân đang có
+ */
+class MoveGenerator {
+private:
+    Board& board;
+    MoveList* moves;          // Danh sách đích của lần sinh hiện tại (do caller cấp)
+    
+    bool capturesOnly;        // Chế độ chỉ sinh nước bắt quân + phong cấp (quiescence)
+    Bitboard targetMask;      // Ô đích cho phép: ~quân mình, hoặc quân địch khi capturesOnly
+    
+    int kingSquare;           // Ô vua bên đang đi (-1 nếu không có vua)
+    Bitboard checkers;        // Quân địch đang chiếu vua
+    Bitboard checkMask;       // Ô mà quân (không phải vua) được đến: chặn/bắt quân chiếu, hoặc tất cả
+    Bitboard pinned;          // Quân mình bị ghim vào vua
+    
+    /**
+     * Tất cả quân (cả hai bên) tấn công square với tập quân cản occupied
+     */
+    Bitboard attackersTo(int square, Bitboard occupied) const;
+    
+    /**
+     * Tính kingSquare, checkers, checkMask, pinned cho bên color
+     */
+    void computeCheckInfo(PieceColor color);
+    
+    /**
+     * Ô đích hợp lệ của quân (không phải vua) tại square: checkMask, giao thêm đường ghim nếu bị ghim
+     */
+    Bitboard allowedTargets(int square) const;
+    
+    /**
+     * Kiểm tra en passant không để vua bị chiếu (hai tốt cùng rời hàng có thể mở đường cho xe/hậu)
+     */
+    bool isEnPassantLegal(int from, int to, PieceColor color) const;
+    
+    /**
+     * Duyệt quân của color và gọi hàm sinh theo loại quân
+     */
+    void generatePieceMoves(PieceColor color, const Position& enPassantTarget);
+    
+    /**
+     * Thêm các move từ ô from tới mọi ô trong tập targets
+     * (targets đã giao với targetMask)
+     */
+    void addMoves(int from, Bitboard targets);
+    
+    /**
+     * Thêm nước phong cấp: một move cho mỗi loại quân có thể phong (Hậu, Xe, Tượng, Mã)
+     */
+    void addPromotions(const Move& base);
+    
+    /**
+     * Sinh nước đi cho Pawn (Tốt)
+     */
+    void generatePawnMoves(int square, PieceColor color, const Position& enPassantTarget);
+    
+    /**
+     * Sinh nước đi cho Knight (Mã) - hình chữ L
+     */
+    void generateKnightMoves(int square);
+    
+    /**
+     * Sinh nước đi cho Bishop (Tượng) - đi chéo
+     */
+    void generateBishopMoves(int square);
+    
+    /**
+     * Sinh nước đi cho Rook (Xe) - đi ngang/dọc
+     */
+    void generateRookMoves(int square);
+    
+    /**
+     * Sinh nước đi cho Queen (Hậu) - kết hợp Rook + Bishop
+     */
+    void generateQueenMoves(int square);
+    
+    /**
+     * Sinh nước đi cho King (Vua) - 8 ô xung quanh, bỏ ô bị tấn công
+     */
+    void generateKingMoves(int square, PieceColor color);
+    
+    /**
+     * Sinh castling moves (nhập thành) - không khi bị chiếu, không đi qua ô bị tấn công
+     */
+    void generateCastlingMoves(
+        PieceColor color,
+        bool kingMoved,
+        bool rookKingSideMoved,
+        bool rookQueenSideMoved
+    );
+
+public:
+    /**
+     * Constructor
+     */
+    MoveGenerator(Board& b)
+        : board(b), moves(nullptr), capturesOnly(false), targetMask(0),
+          kingSquare(-1), checkers(0), checkMask(0), pinned(0) {}
+    
+    /**
+     * Hàm chính: sinh tất cả legal moves cho một bên vào list (xóa nội dung cũ)
+     */
+    void generateMoves(
+        MoveList& list,
+        PieceColor color,
+        const Position& enPassantTarget,
+        bool whiteKingMoved, bool blackKingMoved,
+        bool whiteRookKingSideMoved, bool whiteRookQueenSideMoved,
+        bool blackRookKingSideMoved, bool blackRookQueenSideMoved
+    );
+    
+    /**
+     * Chỉ sinh legal captures (kể cả en passant) và phong cấp
+     * Dùng cho quiescence search - không có castling, không đi tốt thường
+     */
+    void generateCaptures(MoveList& list, PieceColor color, const Position& enPassantTarget);
+};
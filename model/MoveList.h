@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Move.h"
+
+/**
+ * Danh sách nước đi dung lượng cố định, nằm hoàn toàn trên stack (không cấp phát heap)
+ * 256 > số nước đi hợp lệ tối đa của một vị trí cờ vua (218)
+ */
+class MoveList {
+public:
+    static const int MAX_MOVES = 256;
+
+    MoveList() : count(0) {}
+
+    void push_back(const Move& move) { moves[count++] = move; }
+    void clear() { count = 0; }
+
+    /**
+     * Giữ lại count phần tử đầu (dùng khi lọc tại chỗ)
+     */
+    void resize(size_t newSize) { count = static_cast<int>(newSize); }
+
+    size_t size() const { return static_cast<size_t>(count); }
+    bool empty() const { return count == 0; }
+
+    Move& operator[](size_t index) { return moves[index]; }
+    const Move& operator[](size_t index) const { return moves[index]; }
+
+    Move* begin() { return moves; }
+    Move* end() { return moves + count; }
+    const Move* begin() const { return moves; }
+    const Move* end() const { return moves + count; }
+
+private:
+    Move moves[MAX_MOVES];
+    int count;
+};
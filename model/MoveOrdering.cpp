@@ -0,0 +1,101 @@
+#include "MoveOrdering.h"
+
+#include <algorithm>
+
+// Các mức điểm tách biệt từng nhóm nước đi
+static const int HASH_MOVE_SCORE = 1000000;
+static const int CAPTURE_SCORE = 200000;
+static const int PROMOTION_SCORE = 150000;
+static const int KILLER_SCORE = 100000;
+static const int HISTORY_MAX = 50000;
+
+void MoveOrderer::clear() {
+    for (int ply = 0; ply < MAX_PLY; ply++) {
+        killers[ply][0] = Move();
+        killers[ply][1] = Move();
+    }
+    for (int c = 0; c < 2; c++) {
+        for (int from = 0; from < 64; from++) {
+            for (int to = 0; to < 64; to++) {
+                history[c][from][to] = 0;
+            }
+        }
+    }
+}
+
+void MoveOrderer::newSearch() {
+    for (int ply = 0; ply < MAX_PLY; ply++) {
+        killers[ply][0] = Move();
+        killers[ply][1] = Move();
+    }
+    for (int c = 0; c < 2; c++) {
+        for (int from = 0; from < 64; from++) {
+            for (int to = 0; to < 64; to++) {
+                history[c][from][to] /= 2;
+            }
+        }
+    }
+}
+
+void MoveOrderer::scoreMoves(const Board& board, const MoveList& moves, std::uint16_t hashMove,
+                             int ply, int* scores) const {
+    int killerPly = std::min(ply, MAX_PLY - 1);
+
+    for (size_t i = 0; i < moves.size(); i++) {
+        const Move& move = moves[i];
+        int from = move.fromSquare();
+        int to = move.toSquare();
+        Piece attacker = board.pieceAt(from);
+
+        if (hashMove != 0 && move.move16() == hashMove) {
+            scores[i] = HASH_MOVE_SCORE;
+        } else if (move.isCapture()) {
+            // MVV-LVA: quân bị bắt giá trị cao nhất trước, cùng nạn nhân thì quân bắt rẻ nhất trước
+            scores[i] = CAPTURE_SCORE + move.capturedPiece().value * 100 - attacker.value;
+        } else if (move.moveType() == MoveType::PROMOTION) {
+            scores[i] = PROMOTION_SCORE + Piece(move.promotionPiece(), attacker.color).value;
+        } else if (move == killers[killerPly][0]) {
+            scores[i] = KILLER_SCORE + 1;
+        } else if (move == killers[killerPly][1]) {
+            scores[i] = KILLER_SCORE;
+        } else {
+            scores[i] = history[colorIndex(attacker.color)][from][to];
+        }
+    }
+}
+
+void MoveOrderer::pickNext(MoveList& moves, int* scores, size_t index) {
+    size_t best = index;
+    for (size_t i = index + 1; i < moves.size(); i++) {
+        if (scores[i] > scores[best]) best = i;
+    }
+    if (best != index) {
+        std::swap(moves[index], moves[best]);
+        std::swap(scores[index], scores[best]);
+    }
+}
+
+void MoveOrderer::recordCutoff(const Board& board, const Move& move, int ply, int depth) {
+    if (!isQuiet(move)) return;
+
+    if (ply < MAX_PLY && !(move == killers[ply][0])) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
+
+    int from = move.fromSquare();
+    int to = move.toSquare();
+    int& entry = history[colorIndex(board.pieceAt(from).color)][from][to];
+    entry += depth * depth;
+
+    // Tránh tràn sang nhóm killer: chia đôi cả bảng khi quá ngưỡng
+    if (entry >= HISTORY_MAX) {
+        for (int c = 0; c < 2; c++) {
+            for (int f = 0; f < 64; f++) {
+                for (int t = 0; t < 64; t++) {
+                    history[c][f][t] /= 2;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Move.h"
+#include "MoveList.h"
+#include "Board.h"
+
+/**
+ * Sắp xếp nước đi cho alpha-beta: nước tốt thử trước => cắt tỉa sớm hơn
+ * Thứ tự: hash move > bắt quân (MVV-LVA) > phong cấp > killer > history
+ * Mỗi thread search dùng một MoveOrderer riêng (killer/history không chia sẻ)
+ */
+class MoveOrderer {
+public:
+    static const int MAX_PLY = 128;
+
+    MoveOrderer() { clear(); }
+
+    /**
+     * Xóa killer và history (ván mới)
+     */
+    void clear();
+
+    /**
+     * Bắt đầu lượt search mới: xóa killer, giảm một nửa history
+     * (giữ lại kinh nghiệm của lượt trước nhưng không để nó lấn át)
+     */
+    void newSearch();
+
+    /**
+     * Chấm điểm từng nước đi tại một node
+     * @param hashMove: nước đi từ transposition table (packMove, 0 = không có)
+     * @param scores: mảng ít nhất moves.size() phần tử, nhận điểm tương ứng với moves
+     */
+    void scoreMoves(const Board& board, const MoveList& moves, std::uint16_t hashMove,
+                    int ply, int* scores) const;
+
+    /**
+     * Đưa nước có điểm cao nhất trong [index, end) lên vị trí index (selection sort từng bước)
+     * Gọi trong vòng lặp search => node bị cắt sớm không phải sắp xếp hết
+     */
+    static void pickNext(MoveList& moves, int* scores, size_t index);
+
+    /**
+     * Ghi nhận nước đi gây beta cutoff (chỉ nước yên tĩnh: killer + history)
+     */
+    void recordCutoff(const Board& board, const Move& move, int ply, int depth);
+
+    /**
+     * Nước yên tĩnh: không bắt quân, không phong cấp
+     */
+    static bool isQuiet(const Move& move) {
+        return !move.isCapture() && move.moveType() != MoveType::PROMOTION;
+    }
+
+private:
+    Move killers[MAX_PLY][2];     // 2 nước yên tĩnh gây cutoff gần nhất ở mỗi ply
+    int history[2][64][64];       // [colorIndex][from][to] - butterfly history
+};
@@ -0,0 +1,332 @@
+#include "NNUE.h"
+
+#include <fstream>
+#include <cstring>
+#include <cassert>
+#include <algorithm>
+
+#if defined(__AVX2__) || defined(__SSSE3__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+static const int WEIGHT_SHIFT = 6;   // Các lớp dense: weights int8 ứng với giá trị thực x 64
+static const int OUTPUT_SCALE = 16;  // Đầu ra / 16 => centipawn
+
+/**
+ * Chỉ số feature HalfKP theo góc nhìn perspective
+ * Bên Black nhìn bàn lật dọc để hai bên dùng chung weights
+ */
+static int featureIndex(int perspective, int kingSquare, std::uint8_t code, int square) {
+    int type = code & 7;
+    int color = colorIndex(static_cast<PieceColor>(code >> 3));
+    if (perspective == 1) {
+        square ^= 56;
+        kingSquare ^= 56;
+    }
+    int pieceIndex = (type - 1) * 2 + (color == perspective ? 0 : 1);
+    return kingSquare * 640 + pieceIndex * 64 + square;
+}
+
+static void addRow(std::int16_t* values, const std::int16_t* row) {
+#if defined(__AVX2__)
+    for (int i = 0; i < NNUE_L1; i += 16) {
+        __m256i* v = reinterpret_cast<__m256i*>(values + i);
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+        _mm256_store_si256(v, _mm256_add_epi16(_mm256_load_si256(v), w));
+    }
+#elif defined(__SSE2__)
+    for (int i = 0; i < NNUE_L1; i += 8) {
+        __m128i* v = reinterpret_cast<__m128i*>(values + i);
+        __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+        _mm_store_si128(v, _mm_add_epi16(_mm_load_si128(v), w));
+    }
+#else
+    for (int i = 0; i < NNUE_L1; i++) values[i] += row[i];
+#endif
+}
+
+static void subRow(std::int16_t* values, const std::int16_t* row) {
+#if defined(__AVX2__)
+    for (int i = 0; i < NNUE_L1; i += 16) {
+        __m256i* v = reinterpret_cast<__m256i*>(values + i);
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+        _mm256_store_si256(v, _mm256_sub_epi16(_mm256_load_si256(v), w));
+    }
+#elif defined(__SSE2__)
+    for (int i = 0; i < NNUE_L1; i += 8) {
+        __m128i* v = reinterpret_cast<__m128i*>(values + i);
+        __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+        _mm_store_si128(v, _mm_sub_epi16(_mm_load_si128(v), w));
+    }
+#else
+    for (int i = 0; i < NNUE_L1; i++) values[i] -= row[i];
+#endif
+}
+
+/**
+ * Lớp dense: out[j] = bias[j] + sum(input[i] * weights[j][i]) (input là uint8 sau clipped ReLU)
+ * inputSize là bội số của 32
+ */
+static void affine(const std::uint8_t* input, int inputSize, const std::int8_t* weights,
+                   const std::int32_t* bias, int outputSize, std::int32_t* output) {
+    for (int j = 0; j < outputSize; j++) {
+        const std::int8_t* row = weights + j * inputSize;
+#if defined(__AVX2__)
+        const __m256i ones = _mm256_set1_epi16(1);
+        __m256i sum = _mm256_setzero_si256();
+        for (int i = 0; i < inputSize; i += 32) {
+            __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+            __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + i));
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(in, w), ones));
+        }
+        __m128i sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, 0x4E));
+        sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, 0xB1));
+        output[j] = bias[j] + _mm_cvtsi128_si32(sum128);
+#elif defined(__SSSE3__)
+        const __m128i ones = _mm_set1_epi16(1);
+        __m128i sum = _mm_setzero_si128();
+        for (int i = 0; i < inputSize; i += 16) {
+            __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_maddubs_epi16(in, w), ones));
+        }
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+        output[j] = bias[j] + _mm_cvtsi128_si32(sum);
+#else
+        std::int32_t sum = bias[j];
+        for (int i = 0; i < inputSize; i++) {
+            sum += static_cast<std::int32_t>(input[i]) * row[i];
+        }
+        output[j] = sum;
+#endif
+    }
+}
+
+/**
+ * Clipped ReLU sau lớp dense: (x >> WEIGHT_SHIFT) kẹp vào [0, 127]
+ */
+static void clippedRelu(const std::int32_t* input, int size, std::uint8_t* output) {
+    for (int i = 0; i < size; i++) {
+        output[i] = static_cast<std::uint8_t>(std::clamp(input[i] >> WEIGHT_SHIFT, 0, 127));
+    }
+}
+
+void NNUEStack::pushNull() {
+    assert(top + 1 < static_cast<int>(entries.size()));
+    NNUEAccumulator& next = entries[++top];
+    next.computed[0] = next.computed[1] = false;
+    next.dirty.count = 0;
+    next.dirty.kingColor = -1;
+}
+
+void NNUEStack::push(const Board& board, const Move& move) {
+    assert(top + 1 < static_cast<int>(entries.size()));
+    NNUEAccumulator& next = entries[++top];
+    next.computed[0] = next.computed[1] = false;
+
+    DirtyPieces& dirty = next.dirty;
+    int from = move.fromSquare();
+    int to = move.toSquare();
+    std::uint8_t code = board.codeAt(from);
+    int row = from >> 3;
+
+    dirty.count = 0;
+    dirty.kingColor = -1;
+
+    if ((code & 7) == static_cast<int>(PieceType::KING)) {
+        dirty.kingColor = colorIndex(static_cast<PieceColor>(code >> 3));
+    }
+
+    // Quân bị bắt (en passant: tốt nằm cùng hàng ô xuất phát)
+    if (move.capturedCode() != 0) {
+        int capturedSquare = (move.moveType() == MoveType::EN_PASSANT) ? ((from & ~7) | (to & 7)) : to;
+        dirty.code[dirty.count] = move.capturedCode();
+        dirty.from[dirty.count] = static_cast<std::int8_t>(capturedSquare);
+        dirty.to[dirty.count] = -1;
+        dirty.count++;
+    }
+
+    if (move.moveType() == MoveType::PROMOTION) {
+        // Tốt biến mất, quân phong cấp xuất hiện
+        dirty.code[dirty.count] = code;
+        dirty.from[dirty.count] = static_cast<std::int8_t>(from);
+        dirty.to[dirty.count] = -1;
+        dirty.count++;
+
+        dirty.code[dirty.count] = encodePiece(Piece(move.promotionPiece(), static_cast<PieceColor>(code >> 3)));
+        dirty.from[dirty.count] = -1;
+        dirty.to[dirty.count] = static_cast<std::int8_t>(to);
+        dirty.count++;
+        return;
+    }
+
+    dirty.code[dirty.count] = code;
+    dirty.from[dirty.count] = static_cast<std::int8_t>(from);
+    dirty.to[dirty.count] = static_cast<std::int8_t>(to);
+    dirty.count++;
+
+    // Nhập thành: xe đi theo
+    if (move.moveType() == MoveType::CASTLE_KINGSIDE || move.moveType() == MoveType::CASTLE_QUEENSIDE) {
+        bool kingSide = move.moveType() == MoveType::CASTLE_KINGSIDE;
+        int rookFrom = row * 8 + (kingSide ? 7 : 0);
+        dirty.code[dirty.count] = board.codeAt(rookFrom);
+        dirty.from[dirty.count] = static_cast<std::int8_t>(rookFrom);
+        dirty.to[dirty.count] = static_cast<std::int8_t>(row * 8 + (kingSide ? 5 : 3));
+        dirty.count++;
+    }
+}
+
+const char* NNUENetwork::simdPath() {
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSSE3__)
+    return "SSSE3";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+bool NNUENetwork::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    char magic[4];
+    std::uint32_t header[5];
+    file.read(magic, 4);
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!file || std::memcmp(magic, "CGNN", 4) != 0 || header[0] != 1 ||
+        header[1] != NNUE_INPUTS || header[2] != NNUE_L1 || header[3] != NNUE_L2 || header[4] != NNUE_L3) {
+        return false;
+    }
+
+    ftBias.resize(NNUE_L1);
+    ftWeights.resize(static_cast<std::size_t>(NNUE_INPUTS) * NNUE_L1);
+    l1Bias.resize(NNUE_L2);
+    l1Weights.resize(NNUE_L2 * 2 * NNUE_L1);
+    l2Bias.resize(NNUE_L3);
+    l2Weights.resize(NNUE_L3 * NNUE_L2);
+    outWeights.resize(NNUE_L3);
+
+    auto readArray = [&file](auto& values) {
+        file.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(values[0]));
+    };
+    readArray(ftBias);
+    readArray(ftWeights);
+    readArray(l1Bias);
+    readArray(l1Weights);
+    readArray(l2Bias);
+    readArray(l2Weights);
+    file.read(reinterpret_cast<char*>(&outBias), sizeof(outBias));
+    readArray(outWeights);
+
+    return static_cast<bool>(file);
+}
+
+void NNUENetwork::refresh(const Board& board, int perspective, std::int16_t* values) const {
+    std::memcpy(values, ftBias.data(), NNUE_L1 * sizeof(std::int16_t));
+
+    int kingSquare = board.kingSquare(perspective == 0 ? PieceColor::WHITE : PieceColor::BLACK);
+    Bitboard pieces = board.occupied() & ~board.pieces(PieceType::KING);
+    while (pieces) {
+        int square = popLsb(pieces);
+        int feature = featureIndex(perspective, kingSquare, board.codeAt(square), square);
+        addRow(values, &ftWeights[static_cast<std::size_t>(feature) * NNUE_L1]);
+    }
+}
+
+void NNUENetwork::applyDirty(std::int16_t* values, const DirtyPieces& dirty, int perspective,
+                             int kingSquare, bool forward) const {
+    for (int k = 0; k < dirty.count; k++) {
+        if ((dirty.code[k] & 7) == static_cast<int>(PieceType::KING)) continue;
+        int removed = forward ? dirty.from[k] : dirty.to[k];
+        int added = forward ? dirty.to[k] : dirty.from[k];
+        if (removed >= 0) {
+            int feature = featureIndex(perspective, kingSquare, dirty.code[k], removed);
+            subRow(values, &ftWeights[static_cast<std::size_t>(feature) * NNUE_L1]);
+        }
+        if (added >= 0) {
+            int feature = featureIndex(perspective, kingSquare, dirty.code[k], added);
+            addRow(values, &ftWeights[static_cast<std::size_t>(feature) * NNUE_L1]);
+        }
+    }
+}
+
+void NNUENetwork::updateAccumulators(const Board& board, NNUEStack& stack) const {
+    NNUEAccumulator* entries = stack.entries.data();
+    int top = stack.top;
+
+    for (int perspective = 0; perspective < 2; perspective++) {
+        if (entries[top].computed[perspective]) continue;
+
+        // Lùi tới vị trí gần nhất đã có accumulator, trừ khi vua bên này đã đi giữa chừng
+        int base = top;
+        while (base > 0 && !entries[base].computed[perspective] && entries[base].dirty.kingColor != perspective) {
+            base--;
+        }
+
+        // Vua không đổi ô từ base tới top => dùng ô vua hiện tại cho mọi feature
+        int kingSquare = board.kingSquare(perspective == 0 ? PieceColor::WHITE : PieceColor::BLACK);
+
+        if (!entries[base].computed[perspective]) {
+            // base là nước vua (hoặc gốc chưa tính): tính lại từ đầu ở top (chỉ có board hiện tại),
+            // rồi lùi về base bằng dirty pieces để nhánh anh em và lá sâu hơn dùng lại
+            refresh(board, perspective, entries[top].values[perspective]);
+            entries[top].computed[perspective] = true;
+            for (int i = top; i > base; i--) {
+                std::int16_t* values = entries[i - 1].values[perspective];
+                std::memcpy(values, entries[i].values[perspective], NNUE_L1 * sizeof(std::int16_t));
+                applyDirty(values, entries[i].dirty, perspective, kingSquare, false);
+                entries[i - 1].computed[perspective] = true;
+            }
+            continue;
+        }
+
+        for (int i = base + 1; i <= top; i++) {
+            std::int16_t* values = entries[i].values[perspective];
+            std::memcpy(values, entries[i - 1].values[perspective], NNUE_L1 * sizeof(std::int16_t));
+            applyDirty(values, entries[i].dirty, perspective, kingSquare, true);
+            entries[i].computed[perspective] = true;
+        }
+    }
+}
+
+void NNUENetwork::resetStack(const Board& board, NNUEStack& stack) const {
+    stack.reset();
+    for (int perspective = 0; perspective < 2; perspective++) {
+        refresh(board, perspective, stack.entries[0].values[perspective]);
+        stack.entries[0].computed[perspective] = true;
+    }
+}
+
+int NNUENetwork::evaluate(const Board& board, PieceColor sideToMove, NNUEStack& stack) const {
+    updateAccumulators(board, stack);
+    const NNUEAccumulator& accumulator = stack.entries[stack.top];
+
+    // Ghép accumulator: bên đang đi trước, bên kia sau; clipped ReLU về uint8
+    alignas(64) std::uint8_t input[2 * NNUE_L1];
+    int us = colorIndex(sideToMove);
+    for (int half = 0; half < 2; half++) {
+        const std::int16_t* values = accumulator.values[half == 0 ? us : 1 - us];
+        for (int i = 0; i < NNUE_L1; i++) {
+            input[half * NNUE_L1 + i] = static_cast<std::uint8_t>(std::clamp<int>(values[i], 0, 127));
+        }
+    }
+
+    alignas(64) std::int32_t hidden1[NNUE_L2];
+    alignas(64) std::uint8_t hidden1Out[NNUE_L2];
+    alignas(64) std::int32_t hidden2[NNUE_L3];
+    alignas(64) std::uint8_t hidden2Out[NNUE_L3];
+    std::int32_t output;
+
+    affine(input, 2 * NNUE_L1, l1Weights.data(), l1Bias.data(), NNUE_L2, hidden1);
+    clippedRelu(hidden1, NNUE_L2, hidden1Out);
+    affine(hidden1Out, NNUE_L2, l2Weights.data(), l2Bias.data(), NNUE_L3, hidden2);
+    clippedRelu(hidden2, NNUE_L3, hidden2Out);
+    affine(hidden2Out, NNUE_L3, outWeights.data(), &outBias, 1, &output);
+
+    return output / OUTPUT_SCALE;
+}
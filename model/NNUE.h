@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Board.h"
+#include "Move.h"
+
+/**
+ * Đánh giá bằng mạng neural lượng tử hóa kiểu NNUE (chạy trên CPU)
+ *
+ * Kiến trúc: HalfKP(40960) -> 256 x 2 -> 32 -> 32 -> 1
+ * - Input: (ô vua của bên nhìn, quân không phải vua, ô của quân) cho từng bên nhìn
+ * - Lớp đầu (accumulator, int16) cập nhật tăng dần theo quân thay đổi mỗi nước đi
+ * - Các lớp dense int8 dùng AVX2/SSSE3 nếu trình biên dịch bật (CMake: CHESS_NATIVE_ARCH),
+ *   ngược lại dùng vòng lặp thường
+ *
+ * File weights (little-endian):
+ *   "CGNN", uint32 version = 1, uint32 inputs, uint32 l1, uint32 l2, uint32 l3
+ *   int16 ftBias[l1], int16 ftWeights[inputs][l1]
+ *   int32 l1Bias[l2], int8 l1Weights[l2][2 * l1]
+ *   int32 l2Bias[l3], int8 l2Weights[l3][l2]
+ *   int32 outBias,    int8 outWeights[l3]
+ */
+
+static const int NNUE_INPUTS = 64 * 640;  // ô vua x (5 loại quân x 2 màu) x ô
+static const int NNUE_L1 = 256;            // Kích thước accumulator mỗi bên nhìn
+static const int NNUE_L2 = 32;
+static const int NNUE_L3 = 32;
+
+/**
+ * Quân thay đổi bởi một nước đi (tối đa 3: quân đi, quân bị bắt, xe khi nhập thành)
+ * from = -1: quân được thêm (phong cấp); to = -1: quân bị gỡ khỏi bàn
+ */
+struct DirtyPieces {
+    int count;
+    std::uint8_t code[3];
+    std::int8_t from[3];
+    std::int8_t to[3];
+    int kingColor;  // colorIndex của vua vừa đi (-1 nếu không) - bên đó phải tính lại từ đầu
+};
+
+/**
+ * Accumulator lớp đầu của một vị trí, cho cả hai bên nhìn [colorIndex]
+ */
+struct alignas(64) NNUEAccumulator {
+    std::int16_t values[2][NNUE_L1];
+    bool computed[2];
+    DirtyPieces dirty;  // Thay đổi từ vị trí trước (phần tử trước trong stack) tới vị trí này
+};
+
+/**
+ * Stack accumulator theo ply của một thread search
+ * push/pop đi cùng applyMove/unmakeMove; giá trị chỉ được tính khi cần đánh giá (lazy)
+ */
+class NNUEStack {
+private:
+    std::vector<NNUEAccumulator> entries;
+    int top;
+
+    friend class NNUENetwork;
+
+public:
+    explicit NNUEStack(int maxPly) : entries(maxPly + 1), top(0) { reset(); }
+
+    /**
+     * Bắt đầu search mới từ vị trí gốc (chưa tính accumulator nào - xem NNUENetwork::resetStack)
+     */
+    void reset() {
+        top = 0;
+        entries[0].computed[0] = entries[0].computed[1] = false;
+    }
+
+    /**
+     * Ghi lại quân thay đổi của move; gọi TRƯỚC applyMove (board còn ở vị trí cũ)
+     */
+    void push(const Board& board, const Move& move);
+
+    /**
+     * Null move: không quân nào thay đổi, accumulator lấy lại từ vị trí trước
+     */
+    void pushNull();
+    
+    /**
+     * Quay về vị trí trước (sau unmakeMove) - không cần tính lại gì
+     */
+    void pop() { top--; }
+};
+
+/**
+ * Weights của mạng và hàm đánh giá; chỉ đọc sau khi load nên các thread dùng chung được
+ */
+class NNUENetwork {
+private:
+    std::vector<std::int16_t> ftBias;
+    std::vector<std::int16_t> ftWeights;
+    std::vector<std::int32_t> l1Bias;
+    std::vector<std::int8_t> l1Weights;
+    std::vector<std::int32_t> l2Bias;
+    std::vector<std::int8_t> l2Weights;
+    std::int32_t outBias;
+    std::vector<std::int8_t> outWeights;
+
+    /**
+     * Tính accumulator của một bên nhìn từ đầu (theo quân đang trên bàn)
+     */
+    void refresh(const Board& board, int perspective, std::int16_t* values) const;
+
+    /**
+     * Đưa accumulator ở đỉnh stack về trạng thái đúng cho cả hai bên nhìn
+     * Lùi tới vị trí gần nhất đã tính rồi áp các thay đổi; vua bên đó đã đi => refresh
+     */
+    void updateAccumulators(const Board& board, NNUEStack& stack) const;
+
+    /**
+     * Áp thay đổi của một nước lên accumulator (forward = false: hoàn tác, đi từ vị trí sau về trước)
+     */
+    void applyDirty(std::int16_t* values, const DirtyPieces& dirty, int perspective,
+                    int kingSquare, bool forward) const;
+
+public:
+    NNUENetwork() : outBias(0) {}
+
+    /**
+     * Đọc file weights theo định dạng ở đầu file
+     * @return false nếu không mở được hoặc kích thước không khớp kiến trúc
+     */
+    bool load(const std::string& path);
+
+    /**
+     * Đánh giá vị trí hiện tại của board
+     * @param sideToMove: bên đang đi (accumulator của bên này đứng trước)
+     * @return centipawn theo góc nhìn sideToMove
+     */
+    int evaluate(const Board& board, PieceColor sideToMove, NNUEStack& stack) const;
+
+    /**
+     * Bắt đầu search mới: reset stack và tính sẵn accumulator gốc cho cả hai bên nhìn,
+     * để mọi lá cập nhật tăng dần từ gốc thay vì tính lại từ đầu
+     */
+    void resetStack(const Board& board, NNUEStack& stack) const;
+
+    /**
+     * Nhánh SIMD được biên dịch: "AVX2", "SSSE3", "SSE2" hoặc "scalar"
+     */
+    static const char* simdPath();
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <random>
+
+#include "GameState.h"
+#include "MappedFile.h"
+
+/**
+ * Opening book định dạng Polyglot (.bin), được map vào bộ nhớ và tra bằng binary search
+ *
+ * Mỗi entry 16 byte big-endian: key (8) | move (2) | weight (2) | learn (4), sắp xếp theo key
+ * Key Polyglot dùng bảng Random64 (781 số) của chuẩn Polyglot, nhúng sẵn trong OpeningBook.cpp
+ */
+class OpeningBook {
+private:
+    MappedFile file;
+    std::size_t entryCount;
+    std::mt19937 rng;
+
+    /**
+     * Khóa (key) của entry thứ index
+     */
+    std::uint64_t keyAt(std::size_t index) const;
+
+public:
+    OpeningBook() : entryCount(0), rng(std::random_device{}()) {}
+
+    /**
+     * Map file book
+     * @return false nếu file book lỗi (book giữ trạng thái đóng)
+     */
+    bool open(const std::string& bookPath);
+
+    void close();
+
+    bool isOpen() const { return file.isOpen() && entryCount > 0; }
+
+    /**
+     * Khóa Polyglot của vị trí (khác khóa Zobrist nội bộ của GameState)
+     */
+    static std::uint64_t polyglotKey(const GameState& state);
+
+    /**
+     * Chọn ngẫu nhiên một nước trong book theo trọng số
+     * @return Move hợp lệ của vị trí, hoặc Move() nếu vị trí không có trong book
+     */
+    Move probe(GameState& state);
+};
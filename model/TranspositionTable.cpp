@@ -0,0 +1,121 @@
+#include "TranspositionTable.h"
+
+TranspositionTable::TranspositionTable(std::size_t megabytes) : clusterCount(0), generation(0) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(std::size_t megabytes) {
+    std::size_t count = (megabytes * 1024 * 1024) / sizeof(Cluster);
+
+    // Lũy thừa của 2 => index bằng phép AND
+    std::size_t size = 1;
+    while (size * 2 <= count) size *= 2;
+
+    clusters.reset(new Cluster[size]);
+    clusterCount = size;
+    clear();
+}
+
+void TranspositionTable::clear() {
+    for (std::size_t i = 0; i < clusterCount; i++) {
+        for (Slot& slot : clusters[i].slots) {
+            slot.keyXorData.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    generation = 0;
+}
+
+std::uint64_t TranspositionTable::packData(const TTEntry& entry) {
+    return static_cast<std::uint32_t>(entry.score) |
+           (static_cast<std::uint64_t>(entry.move) << 32) |
+           (static_cast<std::uint64_t>(entry.depth) << 48) |
+           (static_cast<std::uint64_t>(entry.genBound) << 56);
+}
+
+TTEntry TranspositionTable::unpackData(ZobristKey key, std::uint64_t data) {
+    TTEntry entry;
+    entry.key = key;
+    entry.score = static_cast<std::int32_t>(static_cast<std::uint32_t>(data));
+    entry.move = static_cast<std::uint16_t>(data >> 32);
+    entry.depth = static_cast<std::uint8_t>(data >> 48);
+    entry.genBound = static_cast<std::uint8_t>(data >> 56);
+    return entry;
+}
+
+bool TranspositionTable::probe(ZobristKey key, TTEntry& out) const {
+    const Cluster& cluster = clusterFor(key);
+
+    for (const Slot& slot : cluster.slots) {
+        std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+        if ((slot.keyXorData.load(std::memory_order_relaxed) ^ data) != key) continue;
+
+        out = unpackData(key, data);
+        if (out.bound() != Bound::NONE) return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(ZobristKey key, int depth, int score, Bound bound, const Move& bestMove) {
+    Cluster& cluster = clusterFor(key);
+    Slot* replace = &cluster.slots[0];
+    TTEntry replaceEntry = TTEntry();
+    bool found = false;
+    int replaceValue = 0;
+
+    for (Slot& slot : cluster.slots) {
+        std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+        ZobristKey slotKey = slot.keyXorData.load(std::memory_order_relaxed) ^ data;
+        TTEntry entry = unpackData(slotKey, data);
+
+        // Cùng vị trí (hoặc ô trống) => ghi vào đây
+        if (slotKey == key || entry.bound() == Bound::NONE) {
+            replace = &slot;
+            replaceEntry = entry;
+            break;
+        }
+
+        // Chọn entry ít giá trị nhất: lượt search cũ hơn, rồi độ sâu thấp hơn
+        int age = (generation - entry.generation()) & 63;
+        int value = entry.depth - 8 * age;
+        if (!found || value < replaceValue) {
+            replace = &slot;
+            replaceEntry = entry;
+            replaceValue = value;
+            found = true;
+        }
+    }
+
+    std::uint16_t move = bestMove.move16();
+    bool sameKey = replaceEntry.key == key && replaceEntry.bound() != Bound::NONE;
+
+    if (sameKey) {
+        // Kết quả nông (vd. quiescence) không được xóa entry sâu của cùng lượt search
+        bool keepOld = bound != Bound::EXACT &&
+                       depth + REPLACE_DEPTH_MARGIN < replaceEntry.depth &&
+                       replaceEntry.generation() == generation;
+        if (keepOld) {
+            if (move != 0 && move != replaceEntry.move) {
+                replaceEntry.move = move;
+                std::uint64_t data = packData(replaceEntry);
+                replace->data.store(data, std::memory_order_relaxed);
+                replace->keyXorData.store(key ^ data, std::memory_order_relaxed);
+            }
+            return;
+        }
+
+        // Giữ nước đi cũ nếu lần search này không có (vd. fail-low)
+        if (move == 0) move = replaceEntry.move;
+    }
+
+    TTEntry entry;
+    entry.key = key;
+    entry.score = score;
+    entry.move = move;
+    entry.depth = static_cast<std::uint8_t>(depth < 0 ? 0 : depth);
+    entry.genBound = static_cast<std::uint8_t>((generation << 2) | static_cast<int>(bound));
+
+    std::uint64_t data = packData(entry);
+    replace->data.store(data, std::memory_order_relaxed);
+    replace->keyXorData.store(key ^ data, std::memory_order_relaxed);
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+
+#include "Move.h"
+#include "Zobrist.h"
+
+/**
+ * Loại giá trị lưu trong bảng (do cắt tỉa alpha-beta)
+ */
+enum class Bound : std::uint8_t {
+    NONE = 0,
+    UPPER = 1,   // Điểm thật <= score (fail-low, không vượt được alpha)
+    LOWER = 2,   // Điểm thật >= score (fail-high, cắt beta)
+    EXACT = 3    // Điểm chính xác
+};
+
+/**
+ * Kết quả tra bảng (bản giải nén của một slot)
+ */
+struct TTEntry {
+    ZobristKey key;
+    std::int32_t score;
+    std::uint16_t move;        // Nước đi tốt nhất (Move::move16), 0 = không có
+    std::uint8_t depth;        // Độ sâu còn lại khi search
+    std::uint8_t genBound;     // bit 0-1 = Bound, bit 2-7 = generation
+
+    Bound bound() const { return static_cast<Bound>(genBound & 3); }
+    std::uint8_t generation() const { return genBound >> 2; }
+};
+
+/**
+ * Transposition table kích thước cố định, dùng chung không khóa giữa các thread search
+ * Chia thành cluster 64 byte (= 1 cache line, 4 slot) => mỗi lần probe chỉ chạm 1 cache line
+ * Thay thế: trùng khóa thì chỉ ghi đè khi kết quả mới EXACT, đủ sâu (>= độ sâu cũ - REPLACE_DEPTH_MARGIN)
+ * hoặc entry cũ thuộc lượt search trước; không thì giữ entry cũ, chỉ cập nhật nước đi.
+ * Khác khóa thì bỏ entry cũ nhất/nông nhất trong cluster
+ *
+ * Mỗi slot 16 byte = data 64-bit (score, move, depth, bound, generation) + (key XOR data)
+ * Hai thread ghi cùng slot có thể làm 2 nửa lệch nhau; khi đọc, key XOR data không khớp
+ * => coi như không có entry, nên không cần lock
+ */
+class TranspositionTable {
+public:
+    static const int CLUSTER_SIZE = 4;
+
+    // Kết quả nông hơn entry cùng khóa tối đa chừng này ply vẫn được ghi đè
+    static const int REPLACE_DEPTH_MARGIN = 2;
+
+    struct Slot {
+        std::atomic<std::uint64_t> keyXorData;
+        std::atomic<std::uint64_t> data;
+    };
+
+    struct alignas(64) Cluster {
+        Slot slots[CLUSTER_SIZE];
+    };
+
+    /**
+     * @param megabytes: dung lượng tối đa (làm tròn xuống lũy thừa của 2 số cluster)
+     */
+    explicit TranspositionTable(std::size_t megabytes = 16);
+
+    /**
+     * Đổi kích thước (xóa toàn bộ nội dung); không gọi khi đang search
+     */
+    void resize(std::size_t megabytes);
+
+    /**
+     * Xóa toàn bộ entry
+     */
+    void clear();
+
+    /**
+     * Bắt đầu lượt search mới - entry của các lượt trước được ưu tiên thay thế
+     */
+    void newSearch() { generation = static_cast<std::uint8_t>((generation + 1) & 63); }
+
+    /**
+     * Tìm entry của vị trí
+     * @return true nếu có (out chứa bản copy entry)
+     */
+    bool probe(ZobristKey key, TTEntry& out) const;
+
+    /**
+     * Lưu kết quả search của vị trí (theo chính sách thay thế ở trên)
+     */
+    void store(ZobristKey key, int depth, int score, Bound bound, const Move& bestMove);
+
+    /**
+     * Dung lượng thực tế (byte)
+     */
+    std::size_t sizeInBytes() const { return clusterCount * sizeof(Cluster); }
+
+private:
+    std::unique_ptr<Cluster[]> clusters;  // new[] tôn trọng alignas(64) từ C++17
+    std::size_t clusterCount;
+    std::uint8_t generation;
+
+    Cluster& clusterFor(ZobristKey key) { return clusters[key & (clusterCount - 1)]; }
+    const Cluster& clusterFor(ZobristKey key) const { return clusters[key & (clusterCount - 1)]; }
+
+    static std::uint64_t packData(const TTEntry& entry);
+    static TTEntry unpackData(ZobristKey key, std::uint64_t data);
+};
@@ -0,0 +1,35 @@
+#include "Zobrist.h"
+
+/**
+ * SplitMix64 - đủ tốt cho khóa Zobrist, không cần magic như Bitboard.cpp
+ */
+static ZobristKey nextKey(ZobristKey& state) {
+    ZobristKey z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+ZobristKeys::ZobristKeys() {
+    ZobristKey seed = 20240101;
+
+    for (int code = 0; code < 24; code++) {
+        int type = code & 7;
+        bool valid = (type >= 1 && type <= 6) && (code >> 3) >= 1;
+        for (int square = 0; square < 64; square++) {
+            piece[code][square] = valid ? nextKey(seed) : 0;
+        }
+    }
+
+    // castling[0] = 0 để vị trí không có quyền castling không bị XOR gì
+    castling[0] = 0;
+    for (int i = 1; i < 16; i++) {
+        castling[i] = nextKey(seed);
+    }
+
+    for (int i = 0; i < 8; i++) {
+        enPassant[i] = nextKey(seed);
+    }
+
+    side = nextKey(seed);
+}
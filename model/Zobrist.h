@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Khóa Zobrist 64-bit cho một vị trí
+ * hash = XOR các khóa ngẫu nhiên của (quân, ô) + quyền castling + cột en passant + lượt đi
+ * Cập nhật tăng dần: mỗi thay đổi chỉ cần XOR khóa tương ứng vào/ra
+ */
+typedef std::uint64_t ZobristKey;
+
+/**
+ * Bảng khóa ngẫu nhiên (seed cố định => hash giống nhau mọi lần chạy)
+ */
+struct ZobristKeys {
+    ZobristKey piece[24][64];  // [mã quân của Board (type | color << 3)][ô], mã 0 = 0
+    ZobristKey castling[16];   // [bit 0-3 = K, Q, k, q]
+    ZobristKey enPassant[8];   // [cột của ô en passant]
+    ZobristKey side;           // XOR vào khi tới lượt Black
+
+    ZobristKeys();
+};
+
+inline const ZobristKeys& zobristKeys() {
+    static const ZobristKeys keys;
+    return keys;
+}
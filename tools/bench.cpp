@@ -0,0 +1,180 @@
+// Chess Game - Search benchmark
+// Đo thời gian search tới độ sâu cố định (time-to-depth) trên bộ vị trí trung cuộc
+// với số thread tăng dần, để kiểm tra Lazy SMP scale theo số core. Không cần SFML.
+//
+// Đồng thời đếm số lần cấp phát heap trong lúc search (mục tiêu: 0 trên mỗi node).
+//
+// Cách dùng:
+//   bench [depth] [maxThreads] [nnueFile]   Mặc định depth 5, thread 1, 2, 4, 8 (tới maxThreads)
+//                                           nnueFile: đánh giá bằng NNUE thay vì material
+//   bench --search [depth]                  1 thread, tắt lần lượt từng kỹ thuật search (PVS,
+//                                           aspiration, null move, LMR, check extension) để so sánh
+//                                           thời gian, số node và effective branching factor
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <new>
+
+#include "model/AIPlayer.h"
+
+// Đếm mọi lần gọi operator new trong chương trình
+static std::atomic<long long> allocationCount(0);
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+/**
+ * Vị trí trung cuộc, Black đi
+ */
+const char* BENCH_POSITIONS[] = {
+    "r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP2BPPP/R2QKB1R b KQ - 0 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 b - - 0 10",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R b KQkq - 0 1",
+    "r2q1rk1/pb1nbppp/1p2pn2/2pp4/2PP4/1PN1PN2/PB2BPPP/R2Q1RK1 b - - 0 10",
+    "2rq1rk1/pp1bppbp/3p1np1/4n3/3NP3/1BN1BP2/PPPQ2PP/2KR3R b - - 0 12",
+};
+
+struct BenchResult {
+    double seconds;
+    long long nodes;
+    long long allocations;  // Số lần cấp phát heap trong getBestMove
+    long long lastDepthNodes;       // Tổng số node khi xong độ sâu cuối / độ sâu trước đó
+    long long previousDepthNodes;   // (tỉ số = effective branching factor)
+};
+
+/**
+ * Search mọi vị trí tới depth với threadCount thread (TT mới cho mỗi vị trí)
+ * networkFile rỗng => đánh giá material
+ */
+BenchResult runBench(int depth, int threadCount, const std::string& networkFile,
+                     const SearchOptions& options = SearchOptions()) {
+    BenchResult result = {0, 0, 0, 0, 0};
+
+    for (const char* fen : BENCH_POSITIONS) {
+        GameState state;
+        state.loadFromFEN(fen);
+
+        AIPlayer ai(depth);
+        ai.setThreads(threadCount);
+        ai.setSearchOptions(options);
+        ai.setInfoCallback([&](const SearchInfo& info) {
+            if (info.depth == depth) result.lastDepthNodes += info.nodes;
+            if (info.depth == depth - 1) result.previousDepthNodes += info.nodes;
+        });
+        if (!networkFile.empty()) {
+            ai.loadNetwork(networkFile);
+            ai.setEvaluator(Evaluator::NNUE);
+        }
+
+        long long allocationsBefore = allocationCount.load();
+        auto start = std::chrono::steady_clock::now();
+        ai.getBestMove(state);
+        result.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.allocations += allocationCount.load() - allocationsBefore;
+        result.nodes += ai.getNodeCount();
+    }
+
+    return result;
+}
+
+/**
+ * So sánh từng kỹ thuật search: bật hết, tắt từng cái, tắt hết (1 thread, material)
+ */
+int runSearchBench(int depth) {
+    struct Variant {
+        const char* name;
+        SearchOptions options;
+    };
+    
+    std::vector<Variant> variants;
+    variants.push_back({"all", SearchOptions()});
+    variants.push_back({"no PVS", SearchOptions()});
+    variants.back().options.principalVariation = false;
+    variants.push_back({"no aspiration", SearchOptions()});
+    variants.back().options.aspirationWindows = false;
+    variants.push_back({"no null move", SearchOptions()});
+    variants.back().options.nullMove = false;
+    variants.push_back({"no LMR", SearchOptions()});
+    variants.back().options.lateMoveReductions = false;
+    variants.push_back({"no check ext", SearchOptions()});
+    variants.back().options.checkExtensions = false;
+    variants.push_back({"none", SearchOptions()});
+    variants.back().options = {false, false, false, false, false};
+
+    std::cout << "Depth " << depth << ", " << (sizeof(BENCH_POSITIONS) / sizeof(BENCH_POSITIONS[0]))
+              << " positions, 1 thread\n\n";
+    std::cout << std::left << std::setw(16) << "Search" << std::setw(12) << "Time (s)"
+              << std::setw(14) << "Nodes" << std::setw(12) << "NPS" << "EBF\n";
+
+    for (const Variant& variant : variants) {
+        BenchResult result = runBench(depth, 1, "", variant.options);
+        double branching = result.previousDepthNodes > 0
+            ? static_cast<double>(result.lastDepthNodes) / result.previousDepthNodes : 0;
+
+        std::cout << std::left << std::setw(16) << variant.name
+                  << std::setw(12) << std::fixed << std::setprecision(3) << result.seconds
+                  << std::setw(14) << result.nodes
+                  << std::setw(12) << static_cast<long long>(result.nodes / result.seconds)
+                  << std::setprecision(2) << branching << "\n";
+    }
+
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && std::string(argv[1]) == "--search") {
+        int depth = (argc >= 3) ? std::atoi(argv[2]) : 6;
+        if (depth < 2) {
+            std::cerr << "Usage: bench --search [depth >= 2]" << std::endl;
+            return 1;
+        }
+        return runSearchBench(depth);
+    }
+
+    int depth = (argc >= 2) ? std::atoi(argv[1]) : 5;
+    int maxThreads = (argc >= 3) ? std::atoi(argv[2]) : 8;
+    std::string networkFile = (argc >= 4) ? argv[3] : "";
+    if (depth < 1 || maxThreads < 1) {
+        std::cerr << "Usage: bench [depth] [maxThreads] [nnueFile]" << std::endl;
+        return 1;
+    }
+    if (!networkFile.empty() && !AIPlayer().loadNetwork(networkFile)) {
+        std::cerr << "ERROR: Cannot load NNUE weights: " << networkFile << std::endl;
+        return 1;
+    }
+
+    std::cout << "Depth " << depth << ", " << (sizeof(BENCH_POSITIONS) / sizeof(BENCH_POSITIONS[0]))
+              << " positions, hardware threads: " << std::thread::hardware_concurrency()
+              << ", eval: " << (networkFile.empty() ? "material" : "NNUE")
+              << (networkFile.empty() ? "" : std::string(" (") + NNUENetwork::simdPath() + ")") << "\n\n";
+    std::cout << std::left << std::setw(9) << "Threads" << std::setw(12) << "Time (s)"
+              << std::setw(10) << "Speedup" << std::setw(14) << "Nodes" << std::setw(12) << "NPS"
+              << std::setw(9) << "Allocs" << "Allocs/node\n";
+
+    double baseline = 0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        BenchResult result = runBench(depth, threads, networkFile);
+        if (threads == 1) baseline = result.seconds;
+
+        std::cout << std::left << std::setw(9) << threads
+                  << std::setw(12) << std::fixed << std::setprecision(3) << result.seconds
+                  << std::setw(10) << std::setprecision(2) << (baseline / result.seconds)
+                  << std::setw(14) << result.nodes
+                  << std::setw(12) << static_cast<long long>(result.nodes / result.seconds)
+                  << std::setw(9) << result.allocations
+                  << std::setprecision(6) << static_cast<double>(result.allocations) / result.nodes << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,363 @@
+// Chess Game - Bitbase generator
+// Sinh bitbase thắng/hòa cho tàn cuộc vua + 1-2 quân đấu vua đơn (KPK, KRK, KQK, KBNK...)
+// bằng retrograde analysis song song, ghi ra file để AIPlayer map vào lúc chạy. Không cần SFML.
+//
+// Cách dùng:
+//   bitbase [outDir] [TABLE...]   Mặc định outDir = public/bitbases, bảng KPK KRK KQK KBNK
+//                                 Bảng con cần cho bắt quân/phong cấp (VD KBK, KNK) được sinh kèm
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <map>
+#include <memory>
+#include <string>
+#include <algorithm>
+#include <filesystem>
+
+#include "model/Bitbase.h"
+#include "model/MoveGenerator.h"
+
+// Trạng thái mỗi chỉ số trong lúc sinh
+// Bên mạnh (White) đi: 0 = chưa biết; bên yếu (Black) đi: 1-8 = số nước chưa chắc thua còn lại
+static const std::uint8_t INVALID = 255;
+static const std::uint8_t WIN = 254;    // Bên mạnh thắng
+static const std::uint8_t DRAW = 253;   // Chắc chắn hòa (hết nước, hoặc bên yếu bắt quân thoát hòa)
+
+/**
+ * Vị trí giải mã từ chỉ số (ô đã chuẩn hóa: bên mạnh là White)
+ */
+struct BitbasePosition {
+    int sideToMove;   // 0 = White (bên mạnh), 1 = Black
+    int whiteKing;
+    int blackKing;
+    int squares[Bitbases::MAX_EXTRA_PIECES];
+};
+
+static BitbasePosition decode(std::uint64_t idx, int count) {
+    BitbasePosition pos;
+    for (int i = count - 1; i >= 0; i--) {
+        pos.squares[i] = static_cast<int>(idx & 63);
+        idx >>= 6;
+    }
+    pos.blackKing = static_cast<int>(idx & 63);
+    pos.whiteKing = static_cast<int>((idx >> 6) & 63);
+    pos.sideToMove = static_cast<int>(idx >> 12);
+    return pos;
+}
+
+static bool attackedBy(const Board& board, int square, PieceColor byColor) {
+    Bitboard occupied = board.occupied();
+    Bitboard queens = board.pieces(PieceType::QUEEN, byColor);
+    return (pawnAttacks(oppositeColor(byColor), square) & board.pieces(PieceType::PAWN, byColor)) ||
+           (knightAttacks(square) & board.pieces(PieceType::KNIGHT, byColor)) ||
+           (kingAttacks(square) & board.pieces(PieceType::KING, byColor)) ||
+           (bishopAttacks(square, occupied) & (board.pieces(PieceType::BISHOP, byColor) | queens)) ||
+           (rookAttacks(square, occupied) & (board.pieces(PieceType::ROOK, byColor) | queens));
+}
+
+/**
+ * Sinh một bảng; các bảng con (ít quân hơn / sau phong cấp) phải có sẵn trong subTables
+ */
+class BitbaseGenerator {
+private:
+    std::vector<PieceType> pieces;
+    int count;
+    std::uint64_t entries;
+    std::unique_ptr<std::atomic<std::uint8_t>[]> state;
+    const Bitbases& subTables;
+    int threadCount;
+
+    /**
+     * Chạy work(begin, end, threadIndex) song song trên [0, total)
+     */
+    template <typename Work>
+    void parallelFor(std::uint64_t total, Work work) {
+        std::vector<std::thread> workers;
+        std::uint64_t chunk = (total + threadCount - 1) / threadCount;
+        for (int t = 0; t < threadCount; t++) {
+            std::uint64_t begin = std::min(total, t * chunk);
+            std::uint64_t end = std::min(total, begin + chunk);
+            workers.emplace_back([=]() { work(begin, end, t); });
+        }
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    void placePieces(Board& board, const BitbasePosition& pos) const {
+        board.setPieceAt(pos.whiteKing, Piece(PieceType::KING, PieceColor::WHITE));
+        board.setPieceAt(pos.blackKing, Piece(PieceType::KING, PieceColor::BLACK));
+        for (int i = 0; i < count; i++) {
+            board.setPieceAt(pos.squares[i], Piece(pieces[i], PieceColor::WHITE));
+        }
+    }
+
+    void removePieces(Board& board, const BitbasePosition& pos) const {
+        board.setPieceAt(pos.whiteKing, Piece());
+        board.setPieceAt(pos.blackKing, Piece());
+        for (int i = 0; i < count; i++) {
+            board.setPieceAt(pos.squares[i], Piece());
+        }
+    }
+
+    /**
+     * Vị trí hợp lệ: các ô khác nhau, hai vua không kề, tốt không ở hàng cuối,
+     * bên vừa đi không bị chiếu
+     */
+    bool isValid(const Board& board, const BitbasePosition& pos) const {
+        if (popCount(board.occupied()) != 2 + count) return false;
+        if (kingAttacks(pos.whiteKing) & squareBB(pos.blackKing)) return false;
+
+        for (int i = 0; i < count; i++) {
+            int row = pos.squares[i] >> 3;
+            if (pieces[i] == PieceType::PAWN && (row == 0 || row == 7)) return false;
+        }
+
+        return pos.sideToMove == 1 || !attackedBy(board, pos.blackKing, PieceColor::WHITE);
+    }
+
+    /**
+     * Kết quả ban đầu của một vị trí: hết nước, bắt quân / phong cấp sang bảng con
+     */
+    std::uint8_t initialState(Board& board, MoveGenerator& generator, MoveList& moves,
+                              const BitbasePosition& pos) const {
+        if (pos.sideToMove == 1) {
+            generator.generateMoves(moves, PieceColor::BLACK, Position(), true, true, true, true, true, true);
+            if (moves.empty()) {
+                return attackedBy(board, pos.blackKing, PieceColor::WHITE) ? WIN : DRAW;
+            }
+
+            int remaining = static_cast<int>(moves.size());
+            for (const Move& move : moves) {
+                if (!move.isCapture()) continue;
+
+                // Vua đen bắt quân => bảng con, White đi (chỉ còn 2 vua thì hòa)
+                Piece captured = board.pieceAt(move.toSquare());
+                board.setPieceAt(move.fromSquare(), Piece());
+                board.setPieceAt(move.toSquare(), Piece(PieceType::KING, PieceColor::BLACK));
+                BitbaseResult result = subTables.probe(board, PieceColor::WHITE);
+                board.setPieceAt(move.toSquare(), captured);
+                board.setPieceAt(move.fromSquare(), Piece(PieceType::KING, PieceColor::BLACK));
+
+                if (result != BitbaseResult::WIN) return DRAW;
+                remaining--;
+            }
+            return remaining == 0 ? WIN : static_cast<std::uint8_t>(remaining);
+        }
+
+        generator.generateMoves(moves, PieceColor::WHITE, Position(), true, true, true, true, true, true);
+        for (const Move& move : moves) {
+            if (move.moveType() != MoveType::PROMOTION) continue;
+
+            // Phong cấp => bảng con, Black đi
+            board.setPieceAt(move.fromSquare(), Piece());
+            board.setPieceAt(move.toSquare(), Piece(move.promotionPiece(), PieceColor::WHITE));
+            BitbaseResult result = subTables.probe(board, PieceColor::BLACK);
+            board.setPieceAt(move.toSquare(), Piece());
+            board.setPieceAt(move.fromSquare(), Piece(PieceType::PAWN, PieceColor::WHITE));
+
+            if (result == BitbaseResult::LOSS) return WIN;
+        }
+        return 0;
+    }
+
+    /**
+     * Vị trí idx vừa được xác định là WIN: cập nhật các vị trí đi tới nó bằng một nước
+     */
+    void propagate(std::uint64_t idx, std::vector<std::uint32_t>& next) {
+        BitbasePosition pos = decode(idx, count);
+        Bitboard occupied = squareBB(pos.whiteKing) | squareBB(pos.blackKing);
+        for (int i = 0; i < count; i++) occupied |= squareBB(pos.squares[i]);
+
+        if (pos.sideToMove == 0) {
+            // Mọi nước của vua đen dẫn tới đây đều thua: giảm bộ đếm của vị trí trước
+            Bitboard sources = kingAttacks(pos.blackKing) & ~occupied;
+            while (sources) {
+                int from = popLsb(sources);
+                std::uint64_t pred = Bitbases::index(1, pos.whiteKing, from, pos.squares, count);
+                std::uint8_t value = state[pred].load(std::memory_order_relaxed);
+                while (value >= 1 && value <= 8) {
+                    std::uint8_t updated = (value == 1) ? WIN : static_cast<std::uint8_t>(value - 1);
+                    if (state[pred].compare_exchange_weak(value, updated, std::memory_order_relaxed)) {
+                        if (updated == WIN) next.push_back(static_cast<std::uint32_t>(pred));
+                        break;
+                    }
+                }
+            }
+            return;
+        }
+
+        // Black đi và thua: White ở vị trí trước chỉ cần đi nước này => thắng
+        auto markWin = [&](std::uint64_t pred) {
+            std::uint8_t expected = 0;
+            if (state[pred].compare_exchange_strong(expected, WIN, std::memory_order_relaxed)) {
+                next.push_back(static_cast<std::uint32_t>(pred));
+            }
+        };
+
+        Bitboard kingSources = kingAttacks(pos.whiteKing) & ~occupied;
+        while (kingSources) {
+            markWin(Bitbases::index(0, popLsb(kingSources), pos.blackKing, pos.squares, count));
+        }
+
+        for (int i = 0; i < count; i++) {
+            int to = pos.squares[i];
+            Bitboard sources = 0;
+            switch (pieces[i]) {
+                case PieceType::KNIGHT: sources = knightAttacks(to); break;
+                case PieceType::BISHOP: sources = bishopAttacks(to, occupied); break;
+                case PieceType::ROOK:   sources = rookAttacks(to, occupied); break;
+                case PieceType::QUEEN:  sources = queenAttacks(to, occupied); break;
+                case PieceType::PAWN:
+                    // Tốt trắng đi lên (row giảm): lùi về row + 1, hoặc row + 2 từ hàng xuất phát
+                    if ((to >> 3) <= 5 && !(occupied & squareBB(to + 8))) {
+                        sources |= squareBB(to + 8);
+                        if ((to >> 3) == 4 && !(occupied & squareBB(to + 16))) sources |= squareBB(to + 16);
+                    }
+                    break;
+                default: break;
+            }
+            sources &= ~occupied;
+
+            int squares[Bitbases::MAX_EXTRA_PIECES];
+            std::copy(pos.squares, pos.squares + count, squares);
+            while (sources) {
+                squares[i] = popLsb(sources);
+                markWin(Bitbases::index(0, pos.whiteKing, pos.blackKing, squares, count));
+            }
+        }
+    }
+
+public:
+    BitbaseGenerator(const std::vector<PieceType>& tablePieces, const Bitbases& tables, int threads)
+        : pieces(tablePieces), count(static_cast<int>(tablePieces.size())),
+          entries(Bitbases::entryCount(count)), state(new std::atomic<std::uint8_t>[entries]),
+          subTables(tables), threadCount(threads) {}
+
+    /**
+     * Sinh bảng, trả về mảng bit (1 = bên mạnh thắng)
+     */
+    std::vector<std::uint8_t> generate() {
+        // Bước 1: đánh dấu vị trí không hợp lệ, kết quả ngay (hết nước, bảng con), bộ đếm nước
+        std::vector<std::vector<std::uint32_t>> found(threadCount);
+        parallelFor(entries, [this, &found](std::uint64_t begin, std::uint64_t end, int t) {
+            Board board;
+            MoveGenerator generator(board);
+            MoveList moves;
+            for (std::uint64_t idx = begin; idx < end; idx++) {
+                BitbasePosition pos = decode(idx, count);
+                placePieces(board, pos);
+                std::uint8_t value = isValid(board, pos) ? initialState(board, generator, moves, pos) : INVALID;
+                state[idx].store(value, std::memory_order_relaxed);
+                if (value == WIN) found[t].push_back(static_cast<std::uint32_t>(idx));
+                removePieces(board, pos);
+            }
+        });
+
+        // Bước 2: lan ngược từ các vị trí thắng theo từng lớp (mỗi lớp chia đều cho các thread)
+        std::vector<std::uint32_t> frontier;
+        for (std::vector<std::uint32_t>& part : found) {
+            frontier.insert(frontier.end(), part.begin(), part.end());
+            part.clear();
+        }
+        while (!frontier.empty()) {
+            parallelFor(frontier.size(), [this, &frontier, &found](std::uint64_t begin, std::uint64_t end, int t) {
+                for (std::uint64_t i = begin; i < end; i++) {
+                    propagate(frontier[i], found[t]);
+                }
+            });
+            frontier.clear();
+            for (std::vector<std::uint32_t>& part : found) {
+                frontier.insert(frontier.end(), part.begin(), part.end());
+                part.clear();
+            }
+        }
+
+        // Bước 3: còn lại (chưa biết) là hòa
+        std::vector<std::uint8_t> bits(entries / 8, 0);
+        for (std::uint64_t idx = 0; idx < entries; idx++) {
+            if (state[idx].load(std::memory_order_relaxed) == WIN) {
+                bits[idx >> 3] |= static_cast<std::uint8_t>(1 << (idx & 7));
+            }
+        }
+        return bits;
+    }
+};
+
+/**
+ * Sinh bảng name (và các bảng con còn thiếu), ghi file vào outDir
+ * @return false nếu tên bảng không hợp lệ hoặc không ghi được file
+ */
+bool generateTable(const std::string& name, const std::string& outDir, Bitbases& tables,
+                   std::map<std::string, std::vector<std::uint8_t>>& generated, int threads) {
+    std::vector<PieceType> pieces;
+    if (!Bitbases::parseName(name, pieces)) {
+        std::cerr << "ERROR: Invalid table name: " << name << std::endl;
+        return false;
+    }
+    std::string canonical = Bitbases::tableName(pieces);
+    if (generated.count(canonical)) return true;
+
+    // Bảng con: bỏ một quân (bị vua đen bắt), tốt phong cấp
+    for (std::size_t i = 0; i < pieces.size(); i++) {
+        std::vector<PieceType> rest = pieces;
+        rest.erase(rest.begin() + i);
+        if (!rest.empty() && !generateTable(Bitbases::tableName(rest), outDir, tables, generated, threads)) {
+            return false;
+        }
+
+        if (pieces[i] != PieceType::PAWN) continue;
+        for (PieceType promoted : {PieceType::QUEEN, PieceType::ROOK, PieceType::BISHOP, PieceType::KNIGHT}) {
+            std::vector<PieceType> after = pieces;
+            after[i] = promoted;
+            if (!generateTable(Bitbases::tableName(after), outDir, tables, generated, threads)) return false;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    BitbaseGenerator generator(pieces, tables, threads);
+    std::vector<std::uint8_t>& bits = generated[canonical] = generator.generate();
+    tables.addTable(pieces, bits.data());
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    long long wins = 0;
+    for (std::uint8_t byte : bits) wins += popCount(byte);
+
+    std::string path = outDir + "/" + canonical + ".bb";
+    std::ofstream file(path, std::ios::binary);
+    std::uint32_t header[4] = {0, 1, static_cast<std::uint32_t>(pieces.size()), 0};
+    std::copy_n("CGBB", 4, reinterpret_cast<char*>(header));
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(bits.data()), static_cast<std::streamsize>(bits.size()));
+    if (!file) {
+        std::cerr << "ERROR: Cannot write " << path << std::endl;
+        return false;
+    }
+
+    std::cout << canonical << ": " << Bitbases::entryCount(static_cast<int>(pieces.size())) << " entries, "
+              << wins << " wins, " << seconds << " s -> " << path << "\n";
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::string outDir = (argc >= 2) ? argv[1] : "public/bitbases";
+    std::vector<std::string> names;
+    for (int i = 2; i < argc; i++) names.push_back(argv[i]);
+    if (names.empty()) names = {"KPK", "KRK", "KQK", "KBNK"};
+
+    std::error_code error;
+    std::filesystem::create_directories(outDir, error);
+
+    int threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::cout << "Generating bitbases into " << outDir << " with " << threads << " threads\n";
+
+    Bitbases tables;
+    std::map<std::string, std::vector<std::uint8_t>> generated;
+    for (const std::string& name : names) {
+        if (!generateTable(name, outDir, tables, generated, threads)) return 1;
+    }
+
+    return 0;
+}
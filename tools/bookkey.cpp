@@ -0,0 +1,67 @@
+// Chess Game - Polyglot key check
+// So khóa Polyglot (OpeningBook::polyglotKey) với các vị trí tham chiếu trong tài liệu Polyglot.
+// Sai một số trong bảng Random64 => không tìm thấy nước nào trong book. Không cần SFML.
+//
+// Cách dùng:
+//   bookkey            Chạy các vị trí tham chiếu, trả về 1 nếu có khóa sai (dùng với ctest)
+
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+
+#include "model/OpeningBook.h"
+
+/**
+ * Vị trí tham chiếu và khóa Polyglot chuẩn
+ */
+struct KeyCase {
+    const char* name;
+    const char* fen;
+    std::uint64_t key;
+};
+
+const KeyCase KEY_SUITE[] = {
+    {"startpos", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        0x463b96181691fc9cULL},
+    {"e2e4", "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1",
+        0x823c9b50fd114196ULL},
+    {"e2e4 d7d5", "rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2",
+        0x0756b94461c50fb0ULL},
+    {"e2e4 d7d5 e4e5", "rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 2",
+        0x662fafb965db29d4ULL},
+    {"e2e4 d7d5 e4e5 f7f5", "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+        0x22a48b5a8e47ff78ULL},
+    {"... e1e2", "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR b kq - 0 3",
+        0x652a607ca3f242c1ULL},
+    {"... e8f7", "rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - - 0 4",
+        0x00fdd303c946bdd9ULL},
+    {"a2a4 b7b5 h2h4 b5b4 c2c4", "rnbqkbnr/p1pppppp/8/8/PpP4P/8/1P1PPPP1/RNBQKBNR b KQkq c3 0 3",
+        0x3c8123ea7b067637ULL},
+    {"... b4c3 a1a3", "rnbqkbnr/p1pppppp/8/8/P6P/R1p5/1P1PPPP1/1NBQKBNR b Kkq - 0 4",
+        0x5c3f9b829b279560ULL},
+};
+
+int main() {
+    int failures = 0;
+
+    for (const KeyCase& test : KEY_SUITE) {
+        GameState state;
+        if (!state.loadFromFEN(test.fen)) {
+            std::cout << "[FAIL] " << test.name << ": invalid FEN\n";
+            failures++;
+            continue;
+        }
+
+        std::uint64_t key = OpeningBook::polyglotKey(state);
+        bool ok = key == test.key;
+        if (!ok) failures++;
+
+        std::cout << (ok ? "[ OK ] " : "[FAIL] ") << test.name << " " << std::hex << std::setfill('0')
+                  << std::setw(16) << key;
+        if (!ok) std::cout << " (expected " << std::setw(16) << test.key << ")";
+        std::cout << std::dec << "\n";
+    }
+
+    std::cout << (failures == 0 ? "All Polyglot keys match.\n" : "Polyglot key MISMATCH!\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+// Chess Game - Perft tool
+// Đếm số node (leaf) của cây nước đi tới độ sâu N để kiểm tra move generation
+// và đo tốc độ (nodes/second). Không cần SFML.
+//
+// Cách dùng:
+//   perft                      Chạy bộ vị trí chuẩn (suite) với độ sâu mặc định
+//   perft --suite [maxDepth]   Chạy suite tới độ sâu maxDepth (nếu có số liệu tham chiếu)
+//   perft <depth> [fen]        Divide: in số node theo từng nước đi gốc
+
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+
+#include "model/GameState.h"
+
+const std::string START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+/**
+ * Vị trí tham chiếu và số node chuẩn theo độ sâu (nodes[0] = depth 1)
+ */
+struct PerftCase {
+    const char* name;
+    const char* fen;
+    int maxDepth;             // Độ sâu chạy mặc định trong suite
+    long long nodes[6];       // 0 = không có số liệu tham chiếu
+};
+
+const PerftCase PERFT_SUITE[] = {
+    {"startpos", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        5, {20, 400, 8902, 197281, 4865609, 119060324}},
+    {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        4, {48, 2039, 97862, 4085603, 193690690, 0}},
+    {"position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        5, {14, 191, 2812, 43238, 674624, 11030083}},
+    {"position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        4, {6, 264, 9467, 422333, 15833292, 0}},
+    {"position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        4, {44, 1486, 62379, 2103487, 89941194, 0}},
+    {"position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        4, {46, 2079, 89890, 3894594, 164075551, 0}},
+};
+
+/**
+ * Đếm số leaf node tới độ sâu depth (bulk counting ở depth 1)
+ */
+long long perft(GameState& state, int depth) {
+    MoveList moves = state.getLegalMoves();
+
+    if (depth <= 1) {
+        return depth == 1 ? static_cast<long long>(moves.size()) : 1;
+    }
+
+    long long nodes = 0;
+    for (const Move& move : moves) {
+        state.applyMove(move);
+        nodes += perft(state, depth - 1);
+        state.unmakeMove();
+    }
+
+    return nodes;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Divide: in số node của từng nước đi gốc, rồi tổng và tốc độ
+ */
+int runDivide(int depth, const std::string& fen) {
+    GameState state;
+    if (!state.loadFromFEN(fen)) {
+        std::cerr << "ERROR: Invalid FEN: " << fen << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    long long total = 0;
+
+    for (const Move& move : state.getLegalMoves()) {
+        state.applyMove(move);
+        long long nodes = perft(state, depth - 1);
+        state.unmakeMove();
+
+        std::cout << move.toNotation() << ": " << nodes << "\n";
+        total += nodes;
+    }
+
+    double seconds = secondsSince(start);
+    std::cout << "\nNodes: " << total << "\n";
+    std::cout << "Time: " << seconds << " s\n";
+    std::cout << "NPS: " << static_cast<long long>(total / (seconds > 0 ? seconds : 1e-9)) << "\n";
+    return 0;
+}
+
+/**
+ * Chạy bộ vị trí chuẩn, so sánh với số node tham chiếu
+ * @return 0 nếu tất cả khớp
+ */
+int runSuite(int depthLimit) {
+    long long totalNodes = 0;
+    double totalSeconds = 0;
+    int failures = 0;
+
+    for (const PerftCase& test : PERFT_SUITE) {
+        GameState state;
+        state.loadFromFEN(test.fen);
+
+        // depthLimit > 0: chạy tới độ sâu đó (nếu có số liệu tham chiếu)
+        int maxDepth = test.maxDepth;
+        if (depthLimit > 0) {
+            maxDepth = depthLimit;
+            while (maxDepth > 0 && (maxDepth > 6 || test.nodes[maxDepth - 1] == 0)) maxDepth--;
+        }
+
+        for (int depth = 1; depth <= maxDepth; depth++) {
+            auto start = std::chrono::steady_clock::now();
+            long long nodes = perft(state, depth);
+            double seconds = secondsSince(start);
+
+            long long expected = test.nodes[depth - 1];
+            bool ok = (nodes == expected);
+            if (!ok) failures++;
+
+            totalNodes += nodes;
+            totalSeconds += seconds;
+
+            std::cout << (ok ? "[ OK ] " : "[FAIL] ") << test.name << " depth " << depth
+                      << ": " << nodes;
+            if (!ok) std::cout << " (expected " << expected << ")";
+            std::cout << "  " << seconds << " s\n";
+        }
+    }
+
+    std::cout << "\nTotal nodes: " << totalNodes << "\n";
+    std::cout << "Total time: " << totalSeconds << " s\n";
+    std::cout << "NPS: " << static_cast<long long>(totalNodes / (totalSeconds > 0 ? totalSeconds : 1e-9)) << "\n";
+    std::cout << (failures == 0 ? "All perft results match.\n" : "Perft MISMATCH!\n");
+
+    return failures == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        return runSuite(0);
+    }
+
+    std::string arg = argv[1];
+
+    if (arg == "--suite") {
+        int depthLimit = (argc >= 3) ? std::atoi(argv[2]) : 0;
+        return runSuite(depthLimit);
+    }
+
+    int depth = std::atoi(argv[1]);
+    if (depth < 1) {
+        std::cerr << "Usage: perft [--suite [maxDepth]] | perft <depth> [fen]" << std::endl;
+        return 1;
+    }
+
+    // FEN có thể được truyền thành nhiều argument (do có dấu cách)
+    std::string fen;
+    for (int i = 2; i < argc; i++) {
+        if (!fen.empty()) fen += " ";
+        fen += argv[i];
+    }
+
+    return runDivide(depth, fen.empty() ? START_FEN : fen);
+}
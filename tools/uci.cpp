@@ -0,0 +1,257 @@
+// Chess Game - UCI engine
+// Chạy AIPlayer không giao diện, nói giao thức UCI qua stdin/stdout để dùng với
+// các công cụ đấu/phân tích chuẩn (cutechess-cli, fastchess, GUI UCI...). Không cần SFML.
+//
+// Lệnh hỗ trợ:
+//   uci, isready, ucinewgame, quit
+//   setoption name Hash value <MB> | setoption name Threads value <n>
+//   position startpos|fen <FEN> [moves <m1> <m2> ...]
+//   go [depth N] [movetime ms] [wtime ms] [btime ms] [winc ms] [binc ms] [movestogo N] [nodes N] [infinite]
+//   stop
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <cstdlib>
+
+#include "model/AIPlayer.h"
+
+static const char* START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+static const int DEFAULT_HASH_MB = 16;
+static const int MAX_HASH_MB = 4096;
+static const int MAX_THREADS = 256;
+
+// Dự phòng độ trễ giao tiếp khi tính thời gian mỗi nước (ms)
+static const int MOVE_OVERHEAD_MS = 30;
+
+/**
+ * Lệnh "go" đã tách tham số (0 = không đặt)
+ */
+struct GoLimits {
+    int depth = 0;
+    int movetime = 0;
+    int time[2] = {0, 0};       // [colorIndex] wtime, btime
+    int increment[2] = {0, 0};  // [colorIndex] winc, binc
+    int movestogo = 0;
+    long long nodes = 0;
+    bool infinite = false;
+};
+
+class UCIEngine {
+private:
+    AIPlayer ai;
+    GameState state;
+    PieceColor searchTurn;  // Bên đi ở gốc của search đang chạy (đổi điểm sang góc nhìn UCI)
+
+    std::thread reporter;   // Chờ search xong rồi in "bestmove"
+    std::mutex outputMutex;
+
+    // "go infinite": chỉ in bestmove sau khi nhận "stop"
+    std::mutex stopMutex;
+    std::condition_variable stopSignal;
+    bool waitForStop;
+
+    void send(const std::string& line) {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        std::cout << line << std::endl;
+    }
+
+    /**
+     * Điểm search (phía Black) -> "cp x" / "mate n" theo góc nhìn bên đang đi ở gốc
+     */
+    std::string formatScore(int blackScore) const {
+        int score = (searchTurn == PieceColor::BLACK) ? blackScore : -blackScore;
+        if (std::abs(score) >= AIPlayer::MATE_BOUND) {
+            int moves = (AIPlayer::MATE_SCORE - std::abs(score) + 1) / 2;
+            return "mate " + std::to_string(score > 0 ? moves : -moves);
+        }
+        return "cp " + std::to_string(score);
+    }
+
+    static std::string moveText(const Move& move) {
+        return move.isNull() ? "0000" : move.toNotation();
+    }
+
+    /**
+     * Dừng search đang chạy (nếu có) và chờ bestmove được in
+     */
+    void stopSearch() {
+        {
+            std::lock_guard<std::mutex> lock(stopMutex);
+            waitForStop = false;
+        }
+        stopSignal.notify_all();
+        ai.stopSearch();
+        if (reporter.joinable()) reporter.join();
+    }
+
+    void handleSetOption(std::istringstream& input) {
+        std::string token, name, value;
+        input >> token;  // "name"
+        while (input >> token && token != "value") {
+            name += (name.empty() ? "" : " ") + token;
+        }
+        std::getline(input >> std::ws, value);
+
+        if (name == "Hash") {
+            int megabytes = std::clamp(std::atoi(value.c_str()), 1, MAX_HASH_MB);
+            ai.setHashSize(static_cast<std::size_t>(megabytes));
+        } else if (name == "Threads") {
+            ai.setThreads(std::clamp(std::atoi(value.c_str()), 1, MAX_THREADS));
+        } else {
+            send("info string unknown option " + name);
+        }
+    }
+
+    void handlePosition(std::istringstream& input) {
+        std::string token, fen;
+        input >> token;
+
+        if (token == "startpos") {
+            fen = START_FEN;
+            input >> token;  // "moves" (nếu có)
+        } else if (token == "fen") {
+            while (input >> token && token != "moves") {
+                fen += (fen.empty() ? "" : " ") + token;
+            }
+        } else {
+            return;
+        }
+
+        if (!state.loadFromFEN(fen)) {
+            send("info string invalid fen " + fen);
+            state.loadFromFEN(START_FEN);
+            return;
+        }
+
+        // makeMove đối chiếu với legal moves => điền loại nước (nhập thành, en passant...)
+        while (input >> token) {
+            if (!state.makeMove(Move::fromNotation(token))) {
+                send("info string illegal move " + token);
+                break;
+            }
+        }
+    }
+
+    /**
+     * Thời gian cho nước này (ms, 0 = không giới hạn)
+     */
+    int allocateTime(const GoLimits& limits) const {
+        if (limits.movetime > 0) return limits.movetime;
+
+        int side = colorIndex(state.getCurrentTurn());
+        int remaining = limits.time[side];
+        if (remaining <= 0) return 0;
+
+        int movesLeft = (limits.movestogo > 0) ? limits.movestogo : 30;
+        int budget = remaining / movesLeft + limits.increment[side] * 3 / 4;
+        return std::max(1, std::min(budget, remaining - MOVE_OVERHEAD_MS));
+    }
+
+    void handleGo(std::istringstream& input) {
+        GoLimits limits;
+        std::string token;
+        while (input >> token) {
+            if (token == "depth") input >> limits.depth;
+            else if (token == "movetime") input >> limits.movetime;
+            else if (token == "wtime") input >> limits.time[0];
+            else if (token == "btime") input >> limits.time[1];
+            else if (token == "winc") input >> limits.increment[0];
+            else if (token == "binc") input >> limits.increment[1];
+            else if (token == "movestogo") input >> limits.movestogo;
+            else if (token == "nodes") input >> limits.nodes;
+            else if (token == "infinite") limits.infinite = true;
+        }
+
+        stopSearch();
+
+        bool depthLimited = limits.depth > 0 && limits.depth < AIPlayer::MAX_SEARCH_DEPTH;
+        ai.setDifficulty(depthLimited ? limits.depth : AIPlayer::MAX_SEARCH_DEPTH);
+        ai.setTimeLimit(limits.infinite ? 0 : allocateTime(limits));
+        ai.setNodeLimit(limits.infinite ? 0 : limits.nodes);
+
+        searchTurn = state.getCurrentTurn();
+        waitForStop = limits.infinite;
+        ai.startSearch(state);
+
+        reporter = std::thread([this]() {
+            Move best = ai.takeResult();
+            {
+                std::unique_lock<std::mutex> lock(stopMutex);
+                stopSignal.wait(lock, [this]() { return !waitForStop; });
+            }
+            send("bestmove " + moveText(best));
+        });
+    }
+
+public:
+    UCIEngine() : searchTurn(PieceColor::WHITE), waitForStop(false) {
+        ai.setHashSize(DEFAULT_HASH_MB);
+        state.loadFromFEN(START_FEN);
+
+        // Gọi trên thread search sau mỗi độ sâu hoàn tất
+        ai.setInfoCallback([this](const SearchInfo& info) {
+            long long nps = info.nodes * 1000 / std::max(1, info.elapsedMs);
+            send("info depth " + std::to_string(info.depth) +
+                 " score " + formatScore(info.score) +
+                 " nodes " + std::to_string(info.nodes) +
+                 " nps " + std::to_string(nps) +
+                 " time " + std::to_string(info.elapsedMs) +
+                 " pv " + moveText(info.bestMove));
+        });
+    }
+
+    ~UCIEngine() { stopSearch(); }
+
+    /**
+     * Đọc lệnh từ stdin tới khi "quit" hoặc hết input
+     */
+    void run() {
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            std::istringstream input(line);
+            std::string command;
+            input >> command;
+
+            if (command == "uci") {
+                send("id name ChessGame");
+                send("id author ChessGame team");
+                send("option name Hash type spin default " + std::to_string(DEFAULT_HASH_MB) +
+                     " min 1 max " + std::to_string(MAX_HASH_MB));
+                send("option name Threads type spin default 1 min 1 max " + std::to_string(MAX_THREADS));
+                send("uciok");
+            } else if (command == "isready") {
+                send("readyok");
+            } else if (command == "ucinewgame") {
+                stopSearch();
+                ai.clearHash();
+                state.loadFromFEN(START_FEN);
+            } else if (command == "setoption") {
+                stopSearch();
+                handleSetOption(input);
+            } else if (command == "position") {
+                stopSearch();
+                handlePosition(input);
+            } else if (command == "go") {
+                handleGo(input);
+            } else if (command == "stop") {
+                stopSearch();
+            } else if (command == "quit") {
+                break;
+            }
+        }
+    }
+};
+
+int main() {
+    std::ios::sync_with_stdio(false);
+
+    UCIEngine engine;
+    engine.run();
+    return 0;
+}
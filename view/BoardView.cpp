@@ -152,7 +152,7 @@ public:
     void showValidMoves(const std::vector<Move>& moves) {
         validMoveSquares.clear();
         for (const Move& move : moves) {
-            validMoveSquares.push_back(move.to);
+            validMoveSquares.push_back(move.to());
         }
     }
     